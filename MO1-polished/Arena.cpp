@@ -0,0 +1,69 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+std::atomic<uint64_t> Arena::live_bytes{0};
+std::atomic<uint64_t> Arena::chunks_allocated{0};
+std::atomic<uint64_t> Arena::objects_created{0};
+
+static constexpr size_t MAX_CHUNK_BYTES = 64 * 1024;
+
+Arena::Arena(size_t first_chunk) : first_chunk_bytes(first_chunk), next_chunk_bytes(first_chunk) {}
+
+Arena::~Arena()
+{
+    reset();
+}
+
+void Arena::add_chunk(size_t min_bytes)
+{
+    size_t size = std::max(next_chunk_bytes, min_bytes);
+    next_chunk_bytes = std::min(next_chunk_bytes * 2, MAX_CHUNK_BYTES);
+
+    auto *chunk = static_cast<Chunk *>(std::malloc(sizeof(Chunk) + size));
+    if (!chunk)
+        throw std::bad_alloc();
+
+    chunk->next = chunks;
+    chunk->size = size;
+    chunks = chunk;
+    cursor = reinterpret_cast<uintptr_t>(chunk + 1);
+    limit = cursor + size;
+
+    reserved += size;
+    live_bytes.fetch_add(size, std::memory_order_relaxed);
+    chunks_allocated.fetch_add(1, std::memory_order_relaxed);
+}
+
+void *Arena::allocate(size_t bytes, size_t align)
+{
+    uintptr_t start = (cursor + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+    if (!chunks || start + bytes > limit)
+    {
+        // Worst-case padding fits in the new chunk too
+        add_chunk(bytes + align);
+        start = (cursor + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+    }
+    cursor = start + bytes;
+    return reinterpret_cast<void *>(start);
+}
+
+void Arena::reset()
+{
+    for (Finalizer *f = finalizers; f; f = f->next)
+        f->destroy(f->object);
+    finalizers = nullptr;
+
+    while (chunks)
+    {
+        Chunk *next = chunks->next;
+        std::free(chunks);
+        chunks = next;
+    }
+    cursor = limit = 0;
+
+    live_bytes.fetch_sub(reserved, std::memory_order_relaxed);
+    reserved = 0;
+    next_chunk_bytes = first_chunk_bytes;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Bump allocator for objects that all die together, such as the commands
+// of one process. Memory comes from a chain of doubling chunks; reset()
+// runs the registered destructors newest first and frees every chunk in
+// one go. Not thread-safe: one arena belongs to one process.
+class Arena
+{
+public:
+    explicit Arena(size_t first_chunk_bytes = 1024);
+    ~Arena();
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    void *allocate(size_t bytes, size_t align);
+
+    template <typename T, typename... Args>
+    T *create(Args &&...args)
+    {
+        objects_created.fetch_add(1, std::memory_order_relaxed);
+        if constexpr (std::is_trivially_destructible_v<T>)
+        {
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+        else
+        {
+            auto *finalizer = static_cast<Finalizer *>(allocate(sizeof(Finalizer), alignof(Finalizer)));
+            T *object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            *finalizer = {[](void *p)
+                          { static_cast<T *>(p)->~T(); },
+                          object, finalizers};
+            finalizers = finalizer;
+            return object;
+        }
+    }
+
+    // Uninitialised storage for n trivially destructible values
+    template <typename T>
+    T *allocate_array(size_t n)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "arena arrays are never destroyed");
+        return static_cast<T *>(allocate(sizeof(T) * n, alignof(T)));
+    }
+
+    void reset();
+
+    size_t bytes_reserved() const { return reserved; }
+
+    // Totals across every arena, for vmstat
+    static uint64_t get_live_bytes() { return live_bytes.load(std::memory_order_relaxed); }
+    static uint64_t get_chunks_allocated() { return chunks_allocated.load(std::memory_order_relaxed); }
+    static uint64_t get_objects_created() { return objects_created.load(std::memory_order_relaxed); }
+
+private:
+    struct Chunk
+    {
+        Chunk *next;
+        size_t size; // usable bytes after the header
+    };
+
+    struct Finalizer
+    {
+        void (*destroy)(void *);
+        void *object;
+        Finalizer *next;
+    };
+
+    void add_chunk(size_t min_bytes);
+
+    size_t first_chunk_bytes;
+    size_t next_chunk_bytes;
+    Chunk *chunks = nullptr;
+    uintptr_t cursor = 0;
+    uintptr_t limit = 0;
+    size_t reserved = 0;
+    Finalizer *finalizers = nullptr;
+
+    static std::atomic<uint64_t> live_bytes;
+    static std::atomic<uint64_t> chunks_allocated;
+    static std::atomic<uint64_t> objects_created;
+};
@@ -0,0 +1,146 @@
+#include "BackingStore.h"
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static constexpr size_t INITIAL_SLOTS = 64;
+
+BackingStore::~BackingStore()
+{
+    close();
+}
+
+bool BackingStore::open(const std::string &file_path, size_t page_size)
+{
+    close();
+    path = file_path;
+    page_bytes = page_size;
+
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                                CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+    file = handle;
+#else
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0)
+        return false;
+#endif
+
+    if (!map(INITIAL_SLOTS))
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void BackingStore::close()
+{
+    unmap();
+#ifdef _WIN32
+    if (file)
+    {
+        CloseHandle(static_cast<HANDLE>(file));
+        file = nullptr;
+        std::remove(path.c_str());
+    }
+#else
+    if (fd >= 0)
+    {
+        ::close(fd);
+        fd = -1;
+        ::unlink(path.c_str());
+    }
+#endif
+    capacity = 0;
+    next_slot = 0;
+    free_slots.clear();
+}
+
+bool BackingStore::map(size_t slots)
+{
+    size_t bytes = slots * page_bytes;
+    unmap();
+
+#ifdef _WIN32
+    uint64_t size = bytes;
+    HANDLE handle = CreateFileMappingA(static_cast<HANDLE>(file), nullptr, PAGE_READWRITE,
+                                       static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+    if (!handle)
+        return false;
+    void *view = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+    if (!view)
+    {
+        CloseHandle(handle);
+        return false;
+    }
+    mapping = handle;
+#else
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+        return false;
+    void *view = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED)
+        return false;
+#endif
+
+    base = static_cast<uint8_t *>(view);
+    capacity = slots;
+    return true;
+}
+
+void BackingStore::unmap()
+{
+    if (!base)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle(static_cast<HANDLE>(mapping));
+    mapping = nullptr;
+#else
+    ::munmap(base, capacity * page_bytes);
+#endif
+    base = nullptr;
+}
+
+int32_t BackingStore::allocate_slot()
+{
+    if (!free_slots.empty())
+    {
+        int32_t slot = free_slots.back();
+        free_slots.pop_back();
+        return slot;
+    }
+
+    // The file keeps its contents across a remap, so used slots survive
+    if (next_slot == capacity && !map(capacity * 2))
+    {
+        map(capacity);
+        return -1;
+    }
+    return static_cast<int32_t>(next_slot++);
+}
+
+void BackingStore::free_slot(int32_t slot)
+{
+    free_slots.push_back(slot);
+}
+
+void BackingStore::write_page(int32_t slot, const uint8_t *page)
+{
+    std::memcpy(base + static_cast<size_t>(slot) * page_bytes, page, page_bytes);
+}
+
+void BackingStore::read_page(int32_t slot, uint8_t *page) const
+{
+    std::memcpy(page, base + static_cast<size_t>(slot) * page_bytes, page_bytes);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Swap file for evicted pages, memory-mapped so page-ins and page-outs are
+// plain copies. Grows by doubling as slots run out. Not thread-safe:
+// MemoryManager only touches it under its frames mutex.
+class BackingStore
+{
+public:
+    BackingStore() = default;
+    ~BackingStore();
+
+    BackingStore(const BackingStore &) = delete;
+    BackingStore &operator=(const BackingStore &) = delete;
+
+    // Creates (truncating) the file; the file is removed again on close()
+    bool open(const std::string &path, size_t page_bytes);
+    void close();
+    bool is_open() const { return base != nullptr; }
+
+    // One page-sized slot, or -1 if the file cannot grow
+    int32_t allocate_slot();
+    void free_slot(int32_t slot);
+
+    void write_page(int32_t slot, const uint8_t *page);
+    void read_page(int32_t slot, uint8_t *page) const;
+
+    size_t get_slots_in_use() const { return next_slot - free_slots.size(); }
+
+private:
+    bool map(size_t slots);
+    void unmap();
+
+    std::string path;
+    size_t page_bytes = 0;
+    size_t capacity = 0; // slots the current mapping holds
+    size_t next_slot = 0;
+    std::vector<int32_t> free_slots;
+    uint8_t *base = nullptr;
+
+#ifdef _WIN32
+    void *file = nullptr;    // HANDLE
+    void *mapping = nullptr; // HANDLE
+#else
+    int fd = -1;
+#endif
+};
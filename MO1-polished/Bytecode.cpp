@@ -0,0 +1,47 @@
+#include "Bytecode.h"
+
+ProgramBuilder::ProgramBuilder(Program &program) : program(program)
+{
+    // Appending to an already compiled program reuses its pools
+    for (size_t i = 0; i < program.strings.size(); ++i)
+        string_index.emplace(program.strings[i], static_cast<uint16_t>(i));
+    for (size_t i = 0; i < program.symbols.size(); ++i)
+        symbol_index.emplace(program.symbols[i], static_cast<uint16_t>(i));
+}
+
+size_t ProgramBuilder::emit(const Instruction &instruction)
+{
+    program.code.push_back(instruction);
+    return program.code.size() - 1;
+}
+
+void ProgramBuilder::patch_target(size_t at, size_t target)
+{
+    program.code[at].imm = static_cast<uint32_t>(target);
+}
+
+uint16_t ProgramBuilder::intern_string(const std::string &text)
+{
+    auto it = string_index.find(text);
+    if (it != string_index.end())
+        return it->second;
+
+    uint16_t index = static_cast<uint16_t>(program.strings.size());
+    program.strings.push_back(text);
+    string_index.emplace(text, index);
+    return index;
+}
+
+uint16_t ProgramBuilder::symbol(const std::string &name)
+{
+    auto it = symbol_index.find(name);
+    if (it != symbol_index.end())
+        return it->second;
+    if (program.symbols.size() >= MAX_VARIABLES)
+        return NO_SLOT;
+
+    uint16_t index = static_cast<uint16_t>(program.symbols.size());
+    program.symbols.push_back(name);
+    symbol_index.emplace(name, index);
+    return index;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Flat instruction stream a process runs. The Command classes are only the
+// front end: each lowers itself into this form through ProgramBuilder.
+enum class OpCode : uint8_t
+{
+    PRINT,     // a = string
+    PRINT_VAR, // a = prefix string, b = symbol
+    DECLARE,   // a = symbol, b = value
+    ADD,       // a = target symbol, b/c = symbol or literal (see flags)
+    SUBTRACT,  // same operands as ADD
+    SLEEP,     // imm = ticks
+    FOR_BEGIN, // a = repeat count, imm = index of matching FOR_END (costs no tick)
+    FOR_END,   // imm = index of matching FOR_BEGIN (costs no tick)
+    READ,      // a = target symbol, imm = address
+    WRITE      // b = symbol or literal (see flags), imm = address
+};
+
+enum OperandFlags : uint8_t
+{
+    OPERAND_B_IS_VAR = 1 << 0,
+    OPERAND_C_IS_VAR = 1 << 1
+};
+
+struct Instruction
+{
+    OpCode op;
+    uint8_t flags;
+    uint16_t a;
+    uint16_t b;
+    uint16_t c;
+    uint32_t imm;
+
+    bool operator==(const Instruction &other) const
+    {
+        return op == other.op && flags == other.flags && a == other.a && b == other.b &&
+               c == other.c && imm == other.imm;
+    }
+};
+
+// Spec caps the symbol table at 64 bytes: 32 uint16 variables per process.
+// Names past the cap compile to NO_SLOT, which reads as 0 and ignores writes.
+static constexpr int MAX_VARIABLES = 32;
+static constexpr uint16_t NO_SLOT = 0xFFFF;
+// FOR nesting the interpreter tracks at run time; deeper loops are unrolled
+static constexpr int MAX_LOOP_DEPTH = 3;
+
+struct Program
+{
+    std::vector<Instruction> code;
+    std::vector<std::string> strings; // PRINT literals
+    std::vector<std::string> symbols; // variable name of each slot (debug output only)
+
+    bool operator==(const Program &other) const
+    {
+        return code == other.code && strings == other.strings && symbols == other.symbols;
+    }
+};
+
+// Written into PRINT literals in place of the process name, so processes
+// that differ only by name share one program image; see ProgramCache
+static constexpr const char *PROCESS_NAME_TOKEN = "{name}";
+
+class ProgramBuilder
+{
+public:
+    explicit ProgramBuilder(Program &program);
+
+    size_t emit(const Instruction &instruction);
+    size_t position() const { return program.code.size(); }
+    void patch_target(size_t at, size_t target);
+
+    uint16_t intern_string(const std::string &text);
+    // Resolves a variable name to its slot, assigning the next free one
+    uint16_t symbol(const std::string &name);
+
+    // FOR nesting around the instructions currently being emitted
+    int loop_depth() const { return depth; }
+    void enter_loop() { ++depth; }
+    void leave_loop() { --depth; }
+
+private:
+    Program &program;
+    int depth = 0;
+    std::unordered_map<std::string, uint16_t> string_index;
+    std::unordered_map<std::string, uint16_t> symbol_index;
+};
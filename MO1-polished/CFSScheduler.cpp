@@ -0,0 +1,129 @@
+#include "CFSScheduler.h"
+#include "Process.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Linux's nice-to-weight table: each step is ~10% of CPU share
+    const uint64_t NICE_WEIGHTS[40] = {
+        88761, 71755, 56483, 46273, 36291,
+        29154, 23254, 18705, 14949, 11916,
+        9548, 7620, 6100, 4904, 3906,
+        3121, 2501, 1991, 1586, 1277,
+        1024, 820, 655, 526, 423,
+        335, 272, 215, 172, 137,
+        110, 87, 70, 56, 45,
+        36, 29, 23, 18, 15};
+
+    // vruntime fixed-point scale, so heavy weights still advance per tick
+    constexpr uint64_t VRUNTIME_SCALE = 1024;
+}
+
+CFSScheduler::CFSScheduler(int num_cores, int min_ins, int max_ins, int target_latency, int min_granularity)
+    : Scheduler(num_cores, min_ins, max_ins),
+      target_latency(std::max(target_latency, 1)),
+      min_granularity(std::max(min_granularity, 1))
+{
+    set_ready_queue("", 0);
+}
+
+CFSScheduler::~CFSScheduler()
+{
+    shutdown();
+}
+
+void CFSScheduler::set_ready_queue(const std::string & /*type*/, int /*capacity*/)
+{
+    // Woken sleepers and new arrivals may start half a latency period
+    // behind the leftmost process, so they run soon without starving it
+    uint64_t credit = static_cast<uint64_t>(target_latency) * VRUNTIME_SCALE / 2;
+    auto queue = std::make_unique<VruntimeTree>(credit);
+    tree = queue.get();
+    ready_queue = std::move(queue);
+}
+
+uint64_t CFSScheduler::weight_of(int nice)
+{
+    return NICE_WEIGHTS[std::min(std::max(nice, -20), 19) + 20];
+}
+
+int CFSScheduler::time_slice(const std::shared_ptr<Process> &process) const
+{
+    return process->sched.slice;
+}
+
+void CFSScheduler::on_dispatch(Process &process, int /*core_id*/)
+{
+    uint64_t weight = weight_of(process.sched.nice);
+    uint64_t runnable = tree->queued_weight() + tree->running_weight.fetch_add(weight, std::memory_order_relaxed) + weight;
+
+    uint64_t slice = static_cast<uint64_t>(target_latency) * weight / runnable;
+    process.sched.slice = static_cast<int>(std::max<uint64_t>(slice, min_granularity));
+}
+
+void CFSScheduler::on_release(Process &process, int core_id)
+{
+    uint64_t weight = weight_of(process.sched.nice);
+    tree->running_weight.fetch_sub(weight, std::memory_order_relaxed);
+
+    // Delay steps hold the core too; charge at least one tick regardless
+    uint64_t ran = std::max<uint64_t>(ticks_held(core_id), 1);
+    process.sched.vruntime += ran * NICE_0_WEIGHT * VRUNTIME_SCALE / weight;
+}
+
+CFSScheduler::VruntimeTree::VruntimeTree(uint64_t sleeper_credit)
+    : sleeper_credit(sleeper_credit)
+{
+}
+
+int CFSScheduler::VruntimeTree::push(std::shared_ptr<Process> process, int /*core_id*/)
+{
+    uint64_t process_weight = weight_of(process->sched.nice);
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // Arrivals and sleepers come back near the front rather than with
+    // the head start their low vruntime would otherwise give them
+    uint64_t floor = min_vruntime.load(std::memory_order_relaxed);
+    floor = floor > sleeper_credit ? floor - sleeper_credit : 0;
+    process->sched.vruntime = std::max(process->sched.vruntime, floor);
+
+    tree.insert(Entry{process->sched.vruntime, next_sequence++, std::move(process)});
+    weight.fetch_add(process_weight, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    return -1;
+}
+
+std::shared_ptr<Process> CFSScheduler::VruntimeTree::try_pop(int /*core_id*/)
+{
+    if (total.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (tree.empty())
+        return nullptr;
+
+    auto leftmost = tree.begin();
+    std::shared_ptr<Process> process = leftmost->process;
+    if (leftmost->vruntime > min_vruntime.load(std::memory_order_relaxed))
+        min_vruntime.store(leftmost->vruntime, std::memory_order_relaxed);
+    tree.erase(leftmost);
+
+    weight.fetch_sub(weight_of(process->sched.nice), std::memory_order_relaxed);
+    total.fetch_sub(1, std::memory_order_relaxed);
+    return process;
+}
+
+size_t CFSScheduler::VruntimeTree::size() const
+{
+    return total.load(std::memory_order_relaxed);
+}
+
+void CFSScheduler::VruntimeTree::collect_stats(std::map<int, std::map<std::string, float>> &stats) const
+{
+    auto &shared = stats[SHARED_STATS];
+    shared["queued"] = static_cast<float>(size());
+    shared["min_vruntime"] = static_cast<float>(min_vruntime.load(std::memory_order_relaxed)) / VRUNTIME_SCALE;
+    shared["queued_weight"] = static_cast<float>(weight.load(std::memory_order_relaxed));
+    shared["running_weight"] = static_cast<float>(running_weight.load(std::memory_order_relaxed));
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Scheduler.h"
+#include <mutex>
+#include <set>
+
+// Completely fair scheduling. Each process accrues virtual runtime: ticks
+// run, scaled by NICE_0_WEIGHT / weight(nice). Runnable processes sit in a
+// tree ordered by vruntime and a core always takes the leftmost. A dispatch
+// is granted target_latency * weight / runnable_weight ticks, never fewer
+// than min_granularity, so every runnable process gets a turn within
+// roughly max(target_latency, runnable * min_granularity) ticks however many
+// there are.
+class CFSScheduler : public Scheduler
+{
+public:
+    static constexpr uint64_t NICE_0_WEIGHT = 1024;
+
+    CFSScheduler(int num_cores, int min_ins, int max_ins, int target_latency, int min_granularity);
+    ~CFSScheduler();
+
+    std::string name() const override { return "CFS Scheduler"; }
+
+    // The tree replaces whatever ready-queue the config asked for
+    void set_ready_queue(const std::string &type, int capacity) override;
+
+    static uint64_t weight_of(int nice);
+
+protected:
+    int time_slice(const std::shared_ptr<Process> &process) const override;
+    void on_dispatch(Process &process, int core_id) override;
+    void on_release(Process &process, int core_id) override;
+
+private:
+    class VruntimeTree : public ReadyQueue
+    {
+    public:
+        explicit VruntimeTree(uint64_t sleeper_credit);
+
+        int push(std::shared_ptr<Process> process, int core_id) override;
+        std::shared_ptr<Process> try_pop(int core_id) override;
+        size_t size() const override;
+        void collect_stats(std::map<int, std::map<std::string, float>> &stats) const override;
+
+        uint64_t queued_weight() const { return weight.load(std::memory_order_relaxed); }
+
+        std::atomic<uint64_t> running_weight{0};
+
+    private:
+        struct Entry
+        {
+            uint64_t vruntime;
+            uint64_t sequence; // FIFO among equal vruntimes
+            std::shared_ptr<Process> process;
+
+            bool operator<(const Entry &other) const
+            {
+                return vruntime != other.vruntime ? vruntime < other.vruntime : sequence < other.sequence;
+            }
+        };
+
+        mutable std::mutex mutex;
+        std::set<Entry> tree;
+        uint64_t next_sequence = 0;
+        uint64_t sleeper_credit;
+        std::atomic<uint64_t> min_vruntime{0}; // never decreases
+        std::atomic<uint64_t> weight{0};
+        std::atomic<size_t> total{0};
+    };
+
+    int target_latency;
+    int min_granularity;
+    VruntimeTree *tree; // owned by ready_queue
+};
@@ -1,22 +1,12 @@
 #include "Command.h"
-#include "Process.h"
+#include "Bytecode.h"
 #include <algorithm>
-#include <iostream>
-#include <thread>
-#include <sstream>
-#include <chrono>
-#include <ctime>
-#include <iostream>
-#include <iomanip>
-
-Process *current_process = nullptr;
+#include <cctype>
 
 PrintCommand::PrintCommand(const std::string &msg) : message(msg) {}
 
-void PrintCommand::execute(Process *proc, int core_id, const std::string &process_name)
+void PrintCommand::compile(ProgramBuilder &builder) const
 {
-    std::string output;
-
     // Handle case: "prefix" + var
     size_t plus_pos = message.find('+');
     if (plus_pos != std::string::npos)
@@ -30,42 +20,47 @@ void PrintCommand::execute(Process *proc, int core_id, const std::string &proces
                      prefix.end());
         var_name.erase(remove_if(var_name.begin(), var_name.end(), ::isspace), var_name.end());
 
-        uint16_t val = proc->get_var(var_name);
-        output = prefix + std::to_string(val);
-    }
-    else
-    {
-        // Remove quotes if present
-        if (!message.empty() && message.front() == '"' && message.back() == '"')
-            output = message.substr(1, message.size() - 2);
-        else
-            output = message;
+        builder.emit({OpCode::PRINT_VAR, 0, builder.intern_string(prefix), builder.symbol(var_name), 0, 0});
+        return;
     }
 
-    // Add Log Entry
-    auto now = std::chrono::system_clock::now();
-    std::time_t time_now = std::chrono::system_clock::to_time_t(now);
-
-    std::ostringstream log_entry;
-    log_entry << "(" << std::put_time(std::localtime(&time_now), "%Y-%m-%d %H:%M:%S") << ") "
-              << "Core:" << core_id << " - PRINT(\"" << output << "\")";
+    // Remove quotes if present
+    std::string output = message;
+    if (!message.empty() && message.front() == '"' && message.back() == '"')
+        output = message.substr(1, message.size() - 2);
 
-    proc->logs.push_back(log_entry.str());
+    builder.emit({OpCode::PRINT, 0, builder.intern_string(output), 0, 0, 0});
 }
 
-SleepCommand::SleepCommand(int duration) : duration_ms(duration) {}
+SleepCommand::SleepCommand(int duration) : duration_ticks(duration) {}
 
-void SleepCommand::execute(Process *proc, int core_id, const std::string &process_name)
+void SleepCommand::compile(ProgramBuilder &builder) const
 {
-    std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+    builder.emit({OpCode::SLEEP, 0, 0, 0, 0, static_cast<uint32_t>(std::max(duration_ticks, 0))});
 }
 
 DeclareCommand::DeclareCommand(const std::string &var, uint16_t val)
     : var_name(var), value(val) {}
 
-void DeclareCommand::execute(Process *proc, int core_id, const std::string &process_name)
+void DeclareCommand::compile(ProgramBuilder &builder) const
 {
-    proc->set_var(var_name, value);
+    builder.emit({OpCode::DECLARE, 0, builder.symbol(var_name), value, 0, 0});
+}
+
+// ADD and SUBTRACT share an operand layout: b/c hold a symbol or a literal
+static void compile_arithmetic(ProgramBuilder &builder, OpCode op, const std::string &target,
+                               const std::string &op1, const std::string &op2,
+                               bool op1_is_var, bool op2_is_var, uint16_t val1, uint16_t val2)
+{
+    uint8_t flags = 0;
+    if (op1_is_var)
+        flags |= OPERAND_B_IS_VAR;
+    if (op2_is_var)
+        flags |= OPERAND_C_IS_VAR;
+
+    uint16_t b = op1_is_var ? builder.symbol(op1) : val1;
+    uint16_t c = op2_is_var ? builder.symbol(op2) : val2;
+    builder.emit({op, flags, builder.symbol(target), b, c, 0});
 }
 
 AddCommand::AddCommand(const std::string &tgt, const std::string &o1, const std::string &o2,
@@ -73,14 +68,9 @@ AddCommand::AddCommand(const std::string &tgt, const std::string &o1, const std:
     : target(tgt), op1(o1), op2(o2), op1_is_var(o1_var), op2_is_var(o2_var),
       val1(v1), val2(v2) {}
 
-void AddCommand::execute(Process *proc, int core_id, const std::string &process_name)
+void AddCommand::compile(ProgramBuilder &builder) const
 {
-    uint16_t a = op1_is_var ? proc->get_var(op1) : val1;
-    uint16_t b = op2_is_var ? proc->get_var(op2) : val2;
-    uint32_t result = a + b;
-    if (result > 65535)
-        result = 65535;
-    proc->set_var(target, static_cast<uint16_t>(result));
+    compile_arithmetic(builder, OpCode::ADD, target, op1, op2, op1_is_var, op2_is_var, val1, val2);
 }
 
 SubtractCommand::SubtractCommand(const std::string &tgt, const std::string &o1, const std::string &o2,
@@ -88,26 +78,62 @@ SubtractCommand::SubtractCommand(const std::string &tgt, const std::string &o1,
     : target(tgt), op1(o1), op2(o2), op1_is_var(o1_var), op2_is_var(o2_var),
       val1(v1), val2(v2) {}
 
-void SubtractCommand::execute(Process *proc, int core_id, const std::string &process_name)
+void SubtractCommand::compile(ProgramBuilder &builder) const
+{
+    compile_arithmetic(builder, OpCode::SUBTRACT, target, op1, op2, op1_is_var, op2_is_var, val1, val2);
+}
+
+ReadCommand::ReadCommand(const std::string &var, uint32_t addr)
+    : var_name(var), address(addr) {}
+
+void ReadCommand::compile(ProgramBuilder &builder) const
+{
+    builder.emit({OpCode::READ, 0, builder.symbol(var_name), 0, 0, address});
+}
+
+WriteCommand::WriteCommand(uint32_t addr, const std::string &var, bool is_var, uint16_t val)
+    : address(addr), value_var(var), value_is_var(is_var), value(val) {}
+
+void WriteCommand::compile(ProgramBuilder &builder) const
 {
-    int32_t a = op1_is_var ? proc->get_var(op1) : val1;
-    int32_t b = op2_is_var ? proc->get_var(op2) : val2;
-    int32_t result = a - b;
-    if (result < 0)
-        result = 0;
-    proc->set_var(target, static_cast<uint16_t>(result));
+    if (value_is_var)
+        builder.emit({OpCode::WRITE, OPERAND_B_IS_VAR, 0, builder.symbol(value_var), 0, address});
+    else
+        builder.emit({OpCode::WRITE, 0, 0, value, 0, address});
 }
 
-ForCommand::ForCommand(const std::vector<std::shared_ptr<Command>> &cmds, int reps)
-    : instructions(cmds), repeat(reps) {}
+ForCommand::ForCommand(Command *const *body, size_t body_size, int reps)
+    : body(body), body_size(body_size), repeat(reps) {}
 
-void ForCommand::execute(Process *proc, int core_id, const std::string &process_name)
+void ForCommand::compile(ProgramBuilder &builder) const
 {
-    for (int i = 0; i < repeat; ++i)
+    uint16_t count = loop_count();
+    if (builder.loop_depth() >= MAX_LOOP_DEPTH)
     {
-        for (auto &cmd : instructions)
+        // No loop frame left at run time; emit the body once per repeat
+        for (uint16_t i = 0; i < count; ++i)
         {
-            cmd->execute(proc, core_id, process_name);
+            for (size_t j = 0; j < body_size; ++j)
+                body[j]->compile(builder);
         }
+        return;
     }
+
+    builder.enter_loop();
+    size_t begin = builder.emit({OpCode::FOR_BEGIN, 0, count, 0, 0, 0});
+    for (size_t i = 0; i < body_size; ++i)
+    {
+        body[i]->compile(builder);
+    }
+    builder.leave_loop();
+    size_t end = builder.emit({OpCode::FOR_END, 0, 0, 0, 0, static_cast<uint32_t>(begin)});
+    builder.patch_target(begin, end);
+}
+
+size_t ForCommand::executed_length() const
+{
+    size_t length = 0;
+    for (size_t i = 0; i < body_size; ++i)
+        length += body[i]->executed_length();
+    return length * loop_count();
 }
@@ -1,17 +1,22 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <memory>
 #include <vector>
 #include <cstdint>
 
-class Process;
+class ProgramBuilder;
 
+// Front end for process programs: each command lowers itself into the flat
+// bytecode that Process::execute interprets (see Bytecode.h)
 class Command
 {
 public:
     virtual ~Command() = default;
-    virtual void execute(Process *proc, int core_id, const std::string &process_name) = 0;
+    virtual void compile(ProgramBuilder &builder) const = 0;
+    // Instructions (ticks) a full run of this command executes
+    virtual size_t executed_length() const { return 1; }
 };
 
 class PrintCommand : public Command
@@ -21,17 +26,17 @@ private:
 
 public:
     PrintCommand(const std::string &msg);
-    void execute(Process *proc, int core_id, const std::string &process_name) override;
+    void compile(ProgramBuilder &builder) const override;
 };
 
 class SleepCommand : public Command
 {
 private:
-    int duration_ms;
+    int duration_ticks;
 
 public:
     SleepCommand(int duration);
-    void execute(Process *proc, int core_id, const std::string &process_name) override;
+    void compile(ProgramBuilder &builder) const override;
 };
 
 class DeclareCommand : public Command
@@ -42,7 +47,7 @@ private:
 
 public:
     DeclareCommand(const std::string &var, uint16_t val);
-    void execute(Process *proc, int core_id, const std::string &process_name) override;
+    void compile(ProgramBuilder &builder) const override;
 };
 
 class AddCommand : public Command
@@ -55,7 +60,7 @@ private:
 public:
     AddCommand(const std::string &tgt, const std::string &o1, const std::string &o2,
                bool o1_var, bool o2_var, uint16_t v1, uint16_t v2);
-    void execute(Process *proc, int core_id, const std::string &process_name) override;
+    void compile(ProgramBuilder &builder) const override;
 };
 
 class SubtractCommand : public Command
@@ -68,16 +73,45 @@ private:
 public:
     SubtractCommand(const std::string &tgt, const std::string &o1, const std::string &o2,
                     bool o1_var, bool o2_var, uint16_t v1, uint16_t v2);
-    void execute(Process *proc, int core_id, const std::string &process_name) override;
+    void compile(ProgramBuilder &builder) const override;
+};
+
+class ReadCommand : public Command
+{
+private:
+    std::string var_name;
+    uint32_t address;
+
+public:
+    ReadCommand(const std::string &var, uint32_t addr);
+    void compile(ProgramBuilder &builder) const override;
+};
+
+class WriteCommand : public Command
+{
+private:
+    uint32_t address;
+    std::string value_var;
+    bool value_is_var;
+    uint16_t value;
+
+public:
+    WriteCommand(uint32_t addr, const std::string &var, bool is_var, uint16_t val);
+    void compile(ProgramBuilder &builder) const override;
 };
 
 class ForCommand : public Command
 {
 private:
-    std::vector<std::shared_ptr<Command>> instructions;
+    Command *const *body; // not owned; lives in the process arena
+    size_t body_size;
     int repeat;
 
+    // repeat as the FOR_BEGIN operand can hold it
+    uint16_t loop_count() const { return static_cast<uint16_t>(std::clamp(repeat, 0, 65535)); }
+
 public:
-    ForCommand(const std::vector<std::shared_ptr<Command>> &cmds, int reps);
-    void execute(Process *proc, int core_id, const std::string &process_name) override;
+    ForCommand(Command *const *body, size_t body_size, int reps);
+    void compile(ProgramBuilder &builder) const override;
+    size_t executed_length() const override;
 };
@@ -4,7 +4,9 @@
 #include "AConsole.h"
 #include "MainConsole.h"
 #include "Process.h"
-#include "ProcessFactory.h"
+#include "MemoryManager.h"
+#include "ProcessPool.h"
+#include "ProgramCache.h"
 #include "ScreenConsole.h"
 #include "SchedulingConsole.h"
 #include "RRScheduler.h"
@@ -14,6 +16,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 #include <iomanip>
 #include <algorithm>
 #include <cctype>
@@ -151,45 +154,81 @@ void ConsoleManager::startCpuLoop()
         return;
 
     runningCpuLoop = true;
-    cpuThread = std::thread(&ConsoleManager::cpuCycleLoop, this);
+    if (virtual_engine)
+        cpuThread = std::thread(&ConsoleManager::virtualCycleLoop, this);
+    else
+        cpuThread = std::thread(&ConsoleManager::cpuCycleLoop, this);
 }
 
 void ConsoleManager::stopCpuLoop()
 {
     // std::cerr << "[DEBUG] stopCpuLoop called\n";
     runningCpuLoop = false;
+    // A slow tick-hz would otherwise hold exit for up to a full period
+    if (tick_pacer)
+        tick_pacer->interrupt();
     if (cpuThread.joinable())
         cpuThread.join();
+    if (tick_executor)
+        tick_executor->stop();
     // std::cerr << "[DEBUG] cpuThread.join() done\n";
 }
 
 void ConsoleManager::cpuCycleLoop()
 {
+    tick_pacer->reset();
     while (runningCpuLoop && isRunning())
     {
         cpu_cycles.fetch_add(1);
-        total_cycles.fetch_add(1);
 
         if (scheduler && scheduler_initialized)
         {
-            auto running = scheduler->get_running_processes();
-            if (!running.empty())
-                busy_cycles.fetch_add(1);
+            if (tick_executor)
+            {
+                // Arrivals first so a process generated this tick can run this tick
+                scheduler->on_tick(cpu_cycles.load());
+                scheduler->record_ticks(1, tick_executor->run_tick() > 0);
+            }
+            else
+            {
+                bool busy = scheduler->any_core_busy();
+                scheduler->on_tick(cpu_cycles.load());
+                scheduler->record_ticks(1, busy);
+            }
+        }
 
-            scheduler->on_cpu_cycle(cpu_cycles.load());
+        tick_pacer->wait();
+    }
+}
+
+void ConsoleManager::virtualCycleLoop()
+{
+    while (runningCpuLoop && isRunning())
+    {
+        uint64_t elapsed = 0;
+        bool busy = false;
+
+        if (!virtual_engine->advance(elapsed, busy))
+        {
+            virtual_engine->wait_for_work();
+            continue;
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        scheduler->record_ticks(elapsed, busy);
     }
 }
 
 double ConsoleManager::getCpuUtilization() const
 {
-    uint64_t total = total_cycles.load();
+    if (!scheduler)
+        return 0.0;
+
+    const VmStats &stats = scheduler->get_vm_stats();
+    uint64_t total = stats.total_ticks.load();
     if (total == 0)
         return 0.0;
 
-    return 100.0 * busy_cycles.load() / total;
+    return 100.0 * stats.active_ticks.load() / total;
 }
 
 void ConsoleManager::processInput()
@@ -255,19 +294,81 @@ void ConsoleManager::processInput()
 
         int num_cpu = cfg.getInt("num-cpu", 2);
         std::string scheduler_type = cfg.getString("scheduler", "rr");
-        int quantum = cfg.getInt("quantum-cycles", 5);
         int batch_freq = cfg.getInt("batch-process-freq", 1);
-        int min_ins = cfg.getInt("min-ins", 1000);
-        int max_ins = cfg.getInt("max-ins", 2000);
         int delay_per_exec = cfg.getInt("delay-per-exec", 100);
+        std::string ready_queue_type = cfg.getString("ready-queue", "mutex");
+        int ready_queue_size = cfg.getInt("ready-queue-size", 4096);
+        exec_mode = cfg.getString("exec-mode", "threaded");
+        int sim_ticks = cfg.getInt("sim-ticks", 0);
+        int worker_threads = cfg.getInt("worker-threads", 0);
+        int log_capacity = cfg.getInt("log-capacity", 64);
+        int max_overall_mem = cfg.getInt("max-overall-mem", 16384);
+        int mem_per_frame = cfg.getInt("mem-per-frame", 16);
+        int mem_per_proc = cfg.getInt("mem-per-proc", 4096);
+        // Generated READ/WRITE need room for one uint16 in every process
+        if (mem_per_proc < 2)
+        {
+            std::cout << "[ERROR] mem-per-proc must be at least 2 bytes.\n";
+            return;
+        }
+        // getInt stops at 31 bits; seeds use the full 64
+        uint64_t seed = 0;
+        try
+        {
+            seed = std::stoull(cfg.getString("seed", "0"));
+        }
+        catch (...)
+        {
+        }
+        int generator_threads = cfg.getInt("generator-threads", 1);
+        int generation_buffer = cfg.getInt("generation-buffer", 64);
+        int rt_percent = cfg.getInt("rt-percent", 0);
+        int rt_deadline = cfg.getInt("rt-deadline", 500);
+        double tick_hz = 1.0;
+        try
+        {
+            tick_hz = std::stod(cfg.getString("tick-hz", "1"));
+        }
+        catch (...)
+        {
+        }
 
-        if (scheduler_type == "rr")
-            scheduler = std::make_unique<RRScheduler>(num_cpu, quantum, min_ins, max_ins, delay_per_exec);
-        else
-            scheduler = std::make_unique<FCFSScheduler>(num_cpu, min_ins, max_ins);
+        MemoryManager::getInstance()->set_replacement_policy(cfg.getString("page-replacement", "clock"));
+        MemoryManager::getInstance()->set_backing_store_path(cfg.getString("backing-store", "csopesy-backing-store"));
+        MemoryManager::getInstance()->configure(static_cast<size_t>(std::max(max_overall_mem, 0)),
+                                                static_cast<size_t>(std::max(mem_per_frame, 0)),
+                                                static_cast<size_t>(std::max(mem_per_proc, 0)));
+
+        scheduler = Scheduler::create(scheduler_type, cfg);
 
         scheduler->set_batch_frequency(batch_freq);
-        scheduler->start_core_threads();
+        scheduler->set_delay_per_exec(delay_per_exec);
+        scheduler->set_log_capacity(log_capacity);
+        scheduler->set_generation(seed, generator_threads, generation_buffer);
+        scheduler->set_realtime(rt_percent, rt_deadline);
+        scheduler->set_ready_queue(ready_queue_type, ready_queue_size);
+
+        if (exec_mode == "virtual")
+        {
+            // Cores are stepped by the engine thread; no per-core threads
+            virtual_engine = std::make_unique<VirtualTimeEngine>(
+                scheduler.get(), cpu_cycles, batch_freq, static_cast<uint64_t>(std::max(sim_ticks, 0)));
+        }
+        else if (exec_mode == "lockstep")
+        {
+            tick_executor = std::make_unique<TickExecutor>(scheduler.get(), num_cpu, num_cpu);
+        }
+        else if (exec_mode == "pooled")
+        {
+            int workers = worker_threads > 0 ? worker_threads
+                                             : static_cast<int>(std::thread::hardware_concurrency());
+            tick_executor = std::make_unique<TickExecutor>(scheduler.get(), num_cpu, std::max(workers, 1));
+        }
+        else
+        {
+            scheduler->start_core_threads();
+        }
+        tick_pacer = std::make_unique<TickPacer>(tick_hz);
         startCpuLoop();
         scheduler_initialized = true;
     }
@@ -281,6 +382,48 @@ void ConsoleManager::processInput()
         }
 
         std::string name = command.substr(10);
+        int nice = 0;
+        int deadline = 0;
+        int tickets = 0;
+
+        // screen -s <name> [-nice <n>] [-deadline <ticks>] [-tickets <n>]:
+        // CFS weight, how many ticks after admission the process is due, and
+        // its lottery/stride share
+        size_t options_pos = name.find(" -");
+        if (options_pos != std::string::npos)
+        {
+            std::istringstream options(name.substr(options_pos));
+            name = name.substr(0, options_pos);
+
+            std::string option, value;
+            while (options >> option)
+            {
+                int parsed;
+                try
+                {
+                    if (!(options >> value))
+                        throw std::invalid_argument(option);
+                    parsed = std::stoi(value);
+                }
+                catch (...)
+                {
+                    std::cout << "[ERROR] " << option << " expects a number.\n";
+                    return;
+                }
+
+                if (option == "-nice" && parsed >= -20 && parsed <= 19)
+                    nice = parsed;
+                else if (option == "-deadline" && parsed > 0)
+                    deadline = parsed;
+                else if (option == "-tickets" && parsed > 0)
+                    tickets = parsed;
+                else
+                {
+                    std::cout << "[ERROR] Usage: screen -s <name> [-nice -20..19] [-deadline <ticks>] [-tickets <n>]\n";
+                    return;
+                }
+            }
+        }
 
         if (hasConsole(name))
         {
@@ -290,9 +433,10 @@ void ConsoleManager::processInput()
 
         createConsole("screen", name);
 
-        auto proc = ProcessFactory::generate_dummy_process(name, scheduler->get_min_instructions(), scheduler->get_max_instructions());
-        proc->add_command(std::make_shared<PrintCommand>("Process " + name + " has completed all its commands."));
+        auto proc = scheduler->create_named_process(name, nice, deadline, tickets);
         scheduler->add_process(proc);
+        if (virtual_engine)
+            virtual_engine->notify();
 
         auto screen = std::dynamic_pointer_cast<ScreenConsole>(m_consoleTable[name]);
         if (screen)
@@ -343,11 +487,24 @@ void ConsoleManager::processInput()
         render_header(log_file);
         render_running_processes(scheduler->get_running_processes(), log_file);
         render_finished_processes(scheduler->get_finished_processes(), log_file);
+        render_core_stats(log_file);
+        render_memory_stats(log_file);
+        render_deadline_stats(log_file);
+        render_share_stats(log_file);
         render_footer(log_file);
         // log_file << "Type \"screen -ls\" to view processes or \"exit\" to quit.\n";
         log_file << std::string(80, '=') << "\n\n";
         log_file.close();
     }
+    else if (command == "vmstat")
+    {
+        if (!scheduler)
+        {
+            std::cout << "[ERROR] Scheduler not initialized.\n";
+            return;
+        }
+        render_vmstat(std::cout);
+    }
     else if (command == "marquee")
     {
         if (!scheduler)
@@ -371,6 +528,8 @@ void ConsoleManager::processInput()
             return;
         }
         scheduler->start();
+        if (virtual_engine)
+            virtual_engine->notify();
         start_flag = true;
         std::cout << "[INFO] Scheduler started.\n";
     }
@@ -399,6 +558,21 @@ void ConsoleManager::processInput()
         }
 
         auto proc = screen->getAttachedProcess();
+        RetiredProcess record;
+        if (!proc && scheduler->find_finished_process(screen->getName(), record))
+        {
+            // Retired and its details released; only the summary is left
+            auto ft = std::chrono::system_clock::to_time_t(record.finish_time);
+            std::cout << "\n[Process Info]\n";
+            std::cout << "Name: " << record.name << "\n";
+            std::cout << "ID: " << record.pid << "\n";
+            std::cout << "Status: Finished\n";
+            std::cout << "Finish Time: " << std::put_time(std::localtime(&ft), "%Y-%m-%d %H:%M:%S") << "\n";
+            std::cout << "Instructions Executed: " << record.instructions << " / " << record.instructions << "\n";
+            std::cout << "(Logs and variables released; only the last " << ProcessRegistry::RECENT_FINISHED
+                      << " finished processes keep them)\n";
+            return;
+        }
         if (!proc)
         {
             std::cout << "[ERROR] No process attached.\n";
@@ -407,7 +581,15 @@ void ConsoleManager::processInput()
 
         std::cout << "\n[Process Info]\n";
         std::cout << "Name: " << proc->getName() << "\n";
-        std::cout << "Status: " << (proc->isFinished() ? "Finished" : "Running") << "\n";
+        std::cout << "ID: " << proc->getPid() << "\n";
+        if (proc->sched.nice != 0)
+            std::cout << "Nice: " << proc->sched.nice << "\n";
+        if (proc->sched.deadline > 0)
+            std::cout << "Deadline: tick " << proc->sched.deadline << " (now "
+                      << scheduler->get_current_tick() << ")\n";
+        if (proc->sched.tickets > 0)
+            std::cout << "Tickets: " << proc->sched.tickets << "\n";
+        std::cout << "Status: " << proc->getStateName() << "\n";
 
         if (proc->hasStarted())
         {
@@ -423,7 +605,23 @@ void ConsoleManager::processInput()
 
         std::cout << "Instructions Executed: " << proc->getCurrentCommandIndex() << " / " << proc->get_instruction_count() << "\n";
 
+        const PageTable &pages = proc->page_table;
+        std::cout << "Page Faults: " << pages.page_faults.load()
+                  << " (page-ins " << pages.page_ins.load()
+                  << ", page-outs " << pages.page_outs.load() << ")\n";
+
+        auto vars = proc->getVariables();
+        if (!vars.empty())
+        {
+            std::cout << "Variables:";
+            for (const auto &[var_name, value] : vars)
+                std::cout << " " << var_name << "=" << value;
+            std::cout << "\n";
+        }
+
         std::cout << "Logs:\n";
+        if (proc->getDroppedLogCount() > 0)
+            std::cout << "(" << proc->getDroppedLogCount() << " older entries dropped)\n";
         for (const auto &log : proc->getLogs())
             std::cout << log << "\n";
     }
@@ -445,19 +643,14 @@ void ConsoleManager::render_header(std::ostream &out)
         return;
     }
 
-    auto stats = scheduler->get_cpu_stats();
-    std::string type = dynamic_cast<FCFSScheduler *>(scheduler.get()) ? "FCFS Scheduler"
-                       : dynamic_cast<RRScheduler *>(scheduler.get()) ? "RR Scheduler"
-                                                                      : "Unknown";
-
-    std::string title = "CSOPESY Operating System Emulator - " + type;
+    std::string title = "CSOPESY Operating System Emulator - " + scheduler->name();
 
     out << title << "\n";
     out << std::string(80, '-') << "\n\n";
 
-    int total_cores = stats.size();
+    int total_cores = scheduler->get_num_cores();
     int used = 0;
-    int running_processes = scheduler->get_running_processes().size();
+    int running_processes = scheduler->get_busy_core_count();
     float current_util = 0.0f;
 
     if (total_cores > 0)
@@ -518,7 +711,7 @@ void ConsoleManager::render_running_processes(const std::vector<std::shared_ptr<
     }
 }
 
-void ConsoleManager::render_finished_processes(const std::vector<std::shared_ptr<Process>> &list, std::ostream &out)
+void ConsoleManager::render_finished_processes(const std::vector<RetiredProcess> &list, std::ostream &out)
 {
     out << "Finished Processes:\n";
     if (list.empty())
@@ -529,11 +722,121 @@ void ConsoleManager::render_finished_processes(const std::vector<std::shared_ptr
 
     for (const auto &p : list)
     {
-        if (!p->isFinished())
+        auto finish = std::chrono::system_clock::to_time_t(p.finish_time);
+        out << " - " << p.name
+            << " (" << std::put_time(std::localtime(&finish), "%Y-%m-%d %H:%M:%S") << ")\n";
+    }
+}
+
+void ConsoleManager::render_core_stats(std::ostream &out)
+{
+    out << "\nCore Statistics:\n";
+    for (const auto &[core_id, values] : scheduler->get_cpu_stats())
+    {
+        if (core_id == ReadyQueue::SHARED_STATS)
+            out << "  Ready queue:";
+        else
+            out << "  Core " << core_id << ":";
+        for (const auto &[key, value] : values)
+            out << " " << key << "=" << value;
+        out << "\n";
+    }
+}
+
+void ConsoleManager::render_deadline_stats(std::ostream &out)
+{
+    const VmStats &stats = scheduler->get_vm_stats();
+    uint64_t met = stats.deadlines_met.load();
+    uint64_t missed = stats.deadlines_missed.load();
+
+    out << "\nDeadlines:\n";
+    if (met + missed == 0)
+    {
+        out << "  (No deadline processes finished)\n";
+        return;
+    }
+    out << "  Met: " << met << "  Missed: " << missed << " ("
+        << std::fixed << std::setprecision(1) << 100.0 * missed / (met + missed) << "%)\n";
+    if (missed > 0)
+        out << "  Lateness: mean " << stats.total_lateness.load() / missed
+            << " ticks, max " << stats.max_lateness.load() << " ticks\n";
+}
+
+void ConsoleManager::render_share_stats(std::ostream &out)
+{
+    // Lottery and stride report "<group>_requested_pct"/"<group>_achieved_pct"
+    const std::string suffix = "_requested_pct";
+    auto stats = scheduler->get_cpu_stats();
+    const auto &shared = stats[ReadyQueue::SHARED_STATS];
+
+    bool header = false;
+    for (const auto &[key, requested] : shared)
+    {
+        if (key.size() <= suffix.size() || key.compare(key.size() - suffix.size(), suffix.size(), suffix) != 0)
             continue;
+        std::string group = key.substr(0, key.size() - suffix.size());
+        auto achieved = shared.find(group + "_achieved_pct");
+        if (!header)
+        {
+            out << "\nShares (requested vs achieved):\n";
+            header = true;
+        }
+        out << "  " << std::left << std::setw(12) << group << std::right << std::fixed << std::setprecision(1)
+            << std::setw(6) << requested << "%  " << std::setw(6)
+            << (achieved != shared.end() ? achieved->second : 0.0f) << "%\n";
+    }
+}
 
-        auto finish = std::chrono::system_clock::to_time_t(p->getFinishTime());
-        out << " - " << p->getName()
-            << " (" << std::put_time(std::localtime(&finish), "%Y-%m-%d %H:%M:%S") << ")\n";
+void ConsoleManager::render_memory_stats(std::ostream &out)
+{
+    MemoryManager *memory = MemoryManager::getInstance();
+    out << "\nMemory (" << memory->get_policy_name() << "):\n";
+    out << "  Frames used: " << memory->get_used_frames() << " / " << memory->get_frame_count()
+        << " (" << memory->get_frame_size() << " bytes each)\n";
+    out << "  Page faults: " << memory->get_page_faults()
+        << "  Page-ins: " << memory->get_page_ins()
+        << "  Page-outs: " << memory->get_page_outs() << "\n";
+}
+
+void ConsoleManager::render_vmstat(std::ostream &out)
+{
+    const VmStats &stats = scheduler->get_vm_stats();
+    MemoryManager *memory = MemoryManager::getInstance();
+
+    out << "\n";
+    out << std::setw(12) << stats.total_ticks.load() << " total ticks\n";
+    out << std::setw(12) << stats.active_ticks.load() << " active ticks\n";
+    out << std::setw(12) << stats.idle_ticks.load() << " idle ticks\n";
+    out << std::setw(11) << std::fixed << std::setprecision(1) << getCpuUtilization() << "% cpu utilization\n";
+    out << std::setw(12) << stats.ready_depth.load() << " ready queue depth (peak "
+        << stats.peak_ready_depth.load() << ")\n";
+    out << std::setw(12) << stats.sleeping.load() << " sleeping processes\n";
+    out << std::setw(12) << stats.processes_created.load() << " processes created\n";
+    out << std::setw(12) << stats.processes_finished.load() << " processes finished\n";
+    out << std::setw(12) << stats.deadlines_met.load() << " deadlines met\n";
+    out << std::setw(12) << stats.deadlines_missed.load() << " deadlines missed\n";
+    out << std::setw(12) << memory->get_used_frames() * memory->get_frame_size() << " used memory (bytes)\n";
+    out << std::setw(12) << (memory->get_frame_count() - memory->get_used_frames()) * memory->get_frame_size()
+        << " free memory (bytes)\n";
+    out << std::setw(12) << memory->get_page_faults() << " page faults\n";
+    out << std::setw(12) << memory->get_page_ins() << " pages paged in\n";
+    out << std::setw(12) << memory->get_page_outs() << " pages paged out\n";
+    out << std::setw(12) << ProgramCache::get_images() << " program images ("
+        << ProgramCache::get_hits() << " shared, " << ProgramCache::get_misses() << " compiled)\n";
+    out << std::setw(12) << Arena::get_live_bytes() << " command arena bytes live\n";
+    out << std::setw(12) << Arena::get_chunks_allocated() << " arena chunks allocated\n";
+    out << std::setw(12) << Arena::get_objects_created() << " commands allocated\n";
+    out << std::setw(12) << ProcessPool::get_live() << " pooled processes live ("
+        << ProcessPool::get_slabs() << " slabs, " << ProcessPool::get_reused() << " reused)\n";
+    out << std::setw(12) << scheduler->get_buffered_processes() << " processes pre-built (seed "
+        << scheduler->get_seed() << ")\n";
+    if (!virtual_engine && tick_pacer)
+    {
+        out << std::setw(12) << tick_pacer->get_hz() << " tick rate (Hz)\n";
+        out << std::setw(12) << tick_pacer->get_overruns() << " tick overruns ("
+            << tick_pacer->get_skipped() << " periods skipped)\n";
+        out << std::setw(12) << tick_pacer->get_mean_jitter_ns() << " mean tick jitter (ns, max "
+            << tick_pacer->get_max_jitter_ns() << ")\n";
     }
+    out << std::setw(12) << host_resident_bytes() / 1024 << " emulator RSS (KiB)\n\n";
 }
@@ -13,6 +13,9 @@
 #include "FCFSScheduler.h"
 #include "RRScheduler.h"
 #include "MarqueeConsole.h"
+#include "VirtualTimeEngine.h"
+#include "TickExecutor.h"
+#include "TickPacer.h"
 
 // Console types
 enum ConsoleType
@@ -47,11 +50,15 @@ private:
 
     static std::atomic<uint64_t> cpu_cycles; // Shared CPU counter
     std::thread cpuThread;
-    bool runningCpuLoop = false;
+    std::atomic<bool> runningCpuLoop{false};
 
     void cpuCycleLoop(); // The actual loop function
-    std::atomic<uint64_t> total_cycles{0};
-    std::atomic<uint64_t> busy_cycles{0};
+    void virtualCycleLoop(); // exec-mode virtual: runs at host speed
+
+    std::string exec_mode = "threaded";
+    std::unique_ptr<VirtualTimeEngine> virtual_engine;
+    std::unique_ptr<TickExecutor> tick_executor; // exec-mode lockstep / pooled
+    std::unique_ptr<TickPacer> tick_pacer;       // tick-hz for the real-time loop
 
 public:
     static ConsoleManager *getInstance();
@@ -69,6 +76,7 @@ public:
 
     static void destroy();
 
+    Scheduler *getScheduler() const { return scheduler.get(); }
     std::shared_ptr<AConsole> getConsoleByName(const std::string &name) const;
 
     void createConsole(const std::string &type, const std::string &name);
@@ -79,7 +87,12 @@ public:
     void render_header(std::ostream &out);
     void render_footer(std::ostream &out);
     void render_running_processes(const std::vector<std::shared_ptr<Process>> &processes, std::ostream &out);
-    void render_finished_processes(const std::vector<std::shared_ptr<Process>> &processes, std::ostream &out);
+    void render_finished_processes(const std::vector<RetiredProcess> &processes, std::ostream &out);
+    void render_core_stats(std::ostream &out);
+    void render_memory_stats(std::ostream &out);
+    void render_deadline_stats(std::ostream &out);
+    void render_share_stats(std::ostream &out);
+    void render_vmstat(std::ostream &out);
 
     void startCpuLoop();
     void stopCpuLoop();
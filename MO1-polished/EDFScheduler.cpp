@@ -0,0 +1,147 @@
+#include "EDFScheduler.h"
+#include "Process.h"
+
+#include <algorithm>
+
+EDFScheduler::EDFScheduler(int num_cores, int min_ins, int max_ins, int quantum)
+    : Scheduler(num_cores, min_ins, max_ins), quantum(std::max(quantum, 1)), on_core(num_cores, nullptr)
+{
+    set_ready_queue("", 0);
+}
+
+EDFScheduler::~EDFScheduler()
+{
+    shutdown();
+}
+
+void EDFScheduler::set_ready_queue(const std::string & /*type*/, int /*capacity*/)
+{
+    auto queue = std::make_unique<DeadlineQueue>();
+    deadline_queue = queue.get();
+    ready_queue = std::move(queue);
+}
+
+void EDFScheduler::on_cpu_cycle(uint64_t cycle_number)
+{
+    Scheduler::on_cpu_cycle(cycle_number);
+    check_preemption();
+}
+
+int EDFScheduler::time_slice(const std::shared_ptr<Process> &process) const
+{
+    return process->sched.deadline > 0 ? 0 : quantum;
+}
+
+void EDFScheduler::on_dispatch(Process &process, int core_id)
+{
+    std::unique_lock<std::mutex> lock(cores_mutex);
+    on_core[core_id] = &process;
+}
+
+void EDFScheduler::on_release(Process & /*process*/, int core_id)
+{
+    std::unique_lock<std::mutex> lock(cores_mutex);
+    on_core[core_id] = nullptr;
+}
+
+void EDFScheduler::check_preemption()
+{
+    uint64_t earliest;
+    if (!deadline_queue->peek_earliest(earliest))
+        return;
+
+    // An idle core will take the job anyway; otherwise evict a best-effort
+    // process, or failing that the latest deadline
+    int victim = -1;
+    uint64_t latest = earliest;
+    std::unique_lock<std::mutex> lock(cores_mutex);
+    for (int core_id = 0; core_id < num_cores; ++core_id)
+    {
+        Process *process = on_core[core_id];
+        if (!process)
+            return;
+        if (preemption_requested(core_id))
+            continue;
+
+        uint64_t deadline = process->sched.deadline > 0 ? process->sched.deadline : UINT64_MAX;
+        if (deadline > latest)
+        {
+            latest = deadline;
+            victim = core_id;
+        }
+    }
+
+    if (victim >= 0)
+    {
+        request_preemption(victim);
+        deadline_queue->preemptions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+int EDFScheduler::DeadlineQueue::push(std::shared_ptr<Process> process, int /*core_id*/)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (process->sched.deadline > 0)
+    {
+        uint64_t deadline = process->sched.deadline;
+        realtime.push(Entry{deadline, next_sequence++, std::move(process)});
+    }
+    else
+    {
+        best_effort.push_back(std::move(process));
+    }
+    total.fetch_add(1, std::memory_order_relaxed);
+    return -1;
+}
+
+std::shared_ptr<Process> EDFScheduler::DeadlineQueue::try_pop(int /*core_id*/)
+{
+    if (total.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    std::shared_ptr<Process> process;
+    if (!realtime.empty())
+    {
+        process = realtime.top().process;
+        realtime.pop();
+    }
+    else if (!best_effort.empty())
+    {
+        process = std::move(best_effort.front());
+        best_effort.pop_front();
+    }
+    else
+    {
+        return nullptr;
+    }
+    total.fetch_sub(1, std::memory_order_relaxed);
+    return process;
+}
+
+size_t EDFScheduler::DeadlineQueue::size() const
+{
+    return total.load(std::memory_order_relaxed);
+}
+
+bool EDFScheduler::DeadlineQueue::peek_earliest(uint64_t &deadline) const
+{
+    if (total.load(std::memory_order_relaxed) == 0)
+        return false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (realtime.empty())
+        return false;
+    deadline = realtime.top().deadline;
+    return true;
+}
+
+void EDFScheduler::DeadlineQueue::collect_stats(std::map<int, std::map<std::string, float>> &stats) const
+{
+    auto &shared = stats[SHARED_STATS];
+    std::unique_lock<std::mutex> lock(mutex);
+    shared["realtime_queued"] = static_cast<float>(realtime.size());
+    shared["best_effort_queued"] = static_cast<float>(best_effort.size());
+    shared["earliest_deadline"] = realtime.empty() ? 0.0f : static_cast<float>(realtime.top().deadline);
+    shared["preemptions"] = static_cast<float>(preemptions.load(std::memory_order_relaxed));
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Scheduler.h"
+#include <deque>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+// Earliest deadline first, with best-effort processes underneath. Processes
+// that carry a deadline are dispatched nearest-deadline first and run until
+// they finish, sleep or are preempted by an earlier deadline. Processes
+// without one only get a core when no deadline process is waiting, and then
+// share it round-robin with a fixed quantum.
+class EDFScheduler : public Scheduler
+{
+public:
+    EDFScheduler(int num_cores, int min_ins, int max_ins, int quantum);
+    ~EDFScheduler();
+
+    std::string name() const override { return "EDF Scheduler"; }
+
+    // The deadline queue replaces whatever ready-queue the config asked for
+    void set_ready_queue(const std::string &type, int capacity) override;
+    // Generates arrivals, then preempts for any earlier deadline
+    void on_cpu_cycle(uint64_t cycle_number) override;
+
+protected:
+    int time_slice(const std::shared_ptr<Process> &process) const override;
+    void on_dispatch(Process &process, int core_id) override;
+    void on_release(Process &process, int core_id) override;
+
+private:
+    class DeadlineQueue : public ReadyQueue
+    {
+    public:
+        int push(std::shared_ptr<Process> process, int core_id) override;
+        std::shared_ptr<Process> try_pop(int core_id) override;
+        size_t size() const override;
+        void collect_stats(std::map<int, std::map<std::string, float>> &stats) const override;
+
+        // Earliest queued deadline; false when no deadline process waits
+        bool peek_earliest(uint64_t &deadline) const;
+
+        std::atomic<uint64_t> preemptions{0};
+
+    private:
+        struct Entry
+        {
+            uint64_t deadline;
+            uint64_t sequence; // FIFO among equal deadlines
+            std::shared_ptr<Process> process;
+
+            bool operator>(const Entry &other) const
+            {
+                return deadline != other.deadline ? deadline > other.deadline : sequence > other.sequence;
+            }
+        };
+
+        mutable std::mutex mutex;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> realtime;
+        std::deque<std::shared_ptr<Process>> best_effort;
+        uint64_t next_sequence = 0;
+        std::atomic<size_t> total{0};
+    };
+
+    void check_preemption();
+
+    int quantum;
+    DeadlineQueue *deadline_queue; // owned by ready_queue
+
+    std::mutex cores_mutex;
+    std::vector<Process *> on_core; // core_id -> process it holds, or nullptr
+};
@@ -11,19 +11,5 @@ public:
     FCFSScheduler(int num_cores, int min_ins, int max_ins);
     ~FCFSScheduler();
 
-    void start() override;
-    void stop_scheduler() override;
-    bool is_scheduler_running() const override;
-    void start_core_threads() override;
-
-    void start_process_generator() override;
-    void on_cpu_cycle(uint64_t cycle_number) override;
-
-protected:
-    void run_core(int core_id) override;
-    void generate_new_process();
-
-private:
-    std::atomic<bool> generating_processes{false};
-    std::thread generator_thread;
+    std::string name() const override { return "FCFS Scheduler"; }
 };
@@ -8,7 +8,6 @@
 // Symbol table: maps variable names to uint16_t values
 extern std::unordered_map<std::string, uint16_t> global_symbol_table;
 
-// Memory heap: simulates memory using address-value pairs
-extern std::unordered_map<int, uint16_t> memory_heap;
+// Simulated memory lives in MemoryManager (see MemoryManager.h)
 
 #endif // GLOBAL_STATE_H
\ No newline at end of file
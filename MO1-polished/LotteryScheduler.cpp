@@ -0,0 +1,88 @@
+#include "LotteryScheduler.h"
+#include "Process.h"
+
+LotteryScheduler::LotteryScheduler(int num_cores, int min_ins, int max_ins, int quantum,
+                                   std::vector<TicketGroup> groups, int default_tickets)
+    : ProportionalShareScheduler(num_cores, min_ins, max_ins, quantum, std::move(groups), default_tickets)
+{
+    set_ready_queue("", 0);
+}
+
+std::unique_ptr<ProportionalShareScheduler::ShareQueue> LotteryScheduler::make_queue(const std::vector<TicketGroup> &groups,
+                                                                                     uint32_t default_tickets)
+{
+    // Own stream, so draws do not shift with the workload
+    return std::make_unique<TicketTree>(groups, default_tickets, get_seed() ^ 0x4C4F5454455259ULL);
+}
+
+LotteryScheduler::TicketTree::TicketTree(const std::vector<TicketGroup> &groups, uint32_t default_tickets, uint64_t seed)
+    : ShareQueue(groups, default_tickets), tree(1, 0), rng(seed)
+{
+}
+
+void LotteryScheduler::TicketTree::add(size_t slot, int64_t delta)
+{
+    for (size_t i = slot + 1; i < tree.size(); i += i & (~i + 1))
+        tree[i] += delta;
+}
+
+void LotteryScheduler::TicketTree::grow()
+{
+    // Double the slots and rebuild the sums in O(n)
+    size_t capacity = slots.empty() ? 16 : slots.size() * 2;
+    size_t old_size = slots.size();
+    slots.resize(capacity);
+    for (size_t slot = capacity; slot-- > old_size;)
+        free_slots.push_back(slot);
+
+    tree.assign(capacity + 1, 0);
+    for (size_t i = 1; i <= capacity; ++i)
+    {
+        if (slots[i - 1])
+            tree[i] += slots[i - 1]->sched.tickets;
+        size_t parent = i + (i & (~i + 1));
+        if (parent <= capacity)
+            tree[parent] += tree[i];
+    }
+}
+
+void LotteryScheduler::TicketTree::insert(std::shared_ptr<Process> process)
+{
+    if (free_slots.empty())
+        grow();
+    size_t slot = free_slots.back();
+    free_slots.pop_back();
+
+    uint32_t tickets = process->sched.tickets;
+    slots[slot] = std::move(process);
+    add(slot, tickets);
+    queued_tickets += tickets;
+}
+
+std::shared_ptr<Process> LotteryScheduler::TicketTree::remove_next()
+{
+    if (queued_tickets == 0)
+        return nullptr;
+
+    // Descend to the slot whose ticket range holds the winner
+    uint64_t winner = rng() % queued_tickets;
+    size_t pos = 0;
+    size_t step = 1;
+    while (step * 2 < tree.size())
+        step *= 2;
+    for (; step > 0; step /= 2)
+    {
+        if (pos + step < tree.size() && tree[pos + step] <= winner)
+        {
+            pos += step;
+            winner -= tree[pos];
+        }
+    }
+
+    std::shared_ptr<Process> process = std::move(slots[pos]);
+    uint32_t tickets = process->sched.tickets;
+    add(pos, -static_cast<int64_t>(tickets));
+    queued_tickets -= tickets;
+    free_slots.push_back(pos);
+    return process;
+}
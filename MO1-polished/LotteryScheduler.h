@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ProportionalShareScheduler.h"
+#include "ProcessFactory.h"
+
+// Lottery scheduling: each free core draws a ticket uniformly from those
+// held by queued processes, and the holder runs for one quantum. Queued
+// processes occupy slots of a Fenwick tree of ticket counts, so a draw
+// walks the tree in O(log n). Draws come from the workload seed, so a
+// virtual-time run is reproducible.
+class LotteryScheduler : public ProportionalShareScheduler
+{
+public:
+    LotteryScheduler(int num_cores, int min_ins, int max_ins, int quantum,
+                     std::vector<TicketGroup> groups, int default_tickets);
+
+    std::string name() const override { return "Lottery Scheduler"; }
+
+protected:
+    std::unique_ptr<ShareQueue> make_queue(const std::vector<TicketGroup> &groups, uint32_t default_tickets) override;
+
+private:
+    class TicketTree : public ShareQueue
+    {
+    public:
+        TicketTree(const std::vector<TicketGroup> &groups, uint32_t default_tickets, uint64_t seed);
+
+    protected:
+        void insert(std::shared_ptr<Process> process) override;
+        std::shared_ptr<Process> remove_next() override;
+
+    private:
+        void add(size_t slot, int64_t delta);
+        void grow();
+
+        std::vector<uint64_t> tree;                   // 1-based Fenwick sums over slots
+        std::vector<std::shared_ptr<Process>> slots;
+        std::vector<size_t> free_slots;
+        uint64_t queued_tickets = 0;
+        WorkloadRng rng;
+    };
+};
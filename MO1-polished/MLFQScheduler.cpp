@@ -0,0 +1,154 @@
+#include "MLFQScheduler.h"
+#include "Process.h"
+
+#include <algorithm>
+#include <sstream>
+
+MLFQScheduler::MLFQScheduler(int num_cores, int min_ins, int max_ins, std::vector<int> quanta, int boost_interval)
+    : Scheduler(num_cores, min_ins, max_ins), quanta(std::move(quanta)), boost_interval(boost_interval)
+{
+    if (this->quanta.empty())
+        this->quanta.push_back(1);
+    set_ready_queue("", 0);
+}
+
+MLFQScheduler::~MLFQScheduler()
+{
+    shutdown();
+}
+
+void MLFQScheduler::set_ready_queue(const std::string & /*type*/, int /*capacity*/)
+{
+    auto queue = std::make_unique<LevelQueue>(static_cast<int>(quanta.size()));
+    level_queue = queue.get();
+    ready_queue = std::move(queue);
+}
+
+void MLFQScheduler::on_cpu_cycle(uint64_t cycle_number)
+{
+    Scheduler::on_cpu_cycle(cycle_number);
+
+    if (boost_interval > 0 && cycle_number % boost_interval == 0)
+        level_queue->boost();
+}
+
+std::vector<int> MLFQScheduler::parse_quanta(const std::string &text, int levels)
+{
+    std::vector<int> result;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        try
+        {
+            result.push_back(std::max(std::stoi(item), 1));
+        }
+        catch (...)
+        {
+        }
+    }
+
+    levels = std::max(levels, 1);
+    if (result.empty())
+        result.push_back(2);
+    while (static_cast<int>(result.size()) < levels)
+        result.push_back(result.back() * 2);
+    result.resize(levels);
+    return result;
+}
+
+int MLFQScheduler::time_slice(const std::shared_ptr<Process> &process) const
+{
+    return quanta[process->sched.level];
+}
+
+void MLFQScheduler::on_slice_expired(Process &process)
+{
+    if (process.sched.level + 1 < static_cast<int>(quanta.size()))
+    {
+        process.sched.level++;
+        level_queue->demotions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void MLFQScheduler::on_wake(Process &process)
+{
+    if (process.sched.level > 0)
+    {
+        process.sched.level--;
+        level_queue->promotions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+MLFQScheduler::LevelQueue::LevelQueue(int levels)
+    : levels(levels)
+{
+}
+
+int MLFQScheduler::LevelQueue::push(std::shared_ptr<Process> process, int /*core_id*/)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    // Missed a boost while running or asleep
+    uint64_t current = boost_epoch.load(std::memory_order_relaxed);
+    if (process->sched.boost_epoch != current)
+    {
+        process->sched.boost_epoch = current;
+        process->sched.level = 0;
+    }
+    levels[process->sched.level].push_back(std::move(process));
+    total.fetch_add(1, std::memory_order_relaxed);
+    return -1;
+}
+
+std::shared_ptr<Process> MLFQScheduler::LevelQueue::try_pop(int /*core_id*/)
+{
+    if (total.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (auto &level : levels)
+    {
+        if (level.empty())
+            continue;
+        std::shared_ptr<Process> process = std::move(level.front());
+        level.pop_front();
+        total.fetch_sub(1, std::memory_order_relaxed);
+        return process;
+    }
+    return nullptr;
+}
+
+size_t MLFQScheduler::LevelQueue::size() const
+{
+    return total.load(std::memory_order_relaxed);
+}
+
+void MLFQScheduler::LevelQueue::boost()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t current = boost_epoch.fetch_add(1, std::memory_order_relaxed) + 1;
+    for (size_t i = 1; i < levels.size(); ++i)
+    {
+        for (auto &process : levels[i])
+            levels[0].push_back(std::move(process));
+        levels[i].clear();
+    }
+    for (auto &process : levels[0])
+    {
+        process->sched.level = 0;
+        process->sched.boost_epoch = current;
+    }
+}
+
+void MLFQScheduler::LevelQueue::collect_stats(std::map<int, std::map<std::string, float>> &stats) const
+{
+    auto &shared = stats[SHARED_STATS];
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (size_t i = 0; i < levels.size(); ++i)
+            shared["level" + std::to_string(i) + "_depth"] = static_cast<float>(levels[i].size());
+    }
+    shared["boosts"] = static_cast<float>(boost_epoch.load(std::memory_order_relaxed));
+    shared["demotions"] = static_cast<float>(demotions.load(std::memory_order_relaxed));
+    shared["promotions"] = static_cast<float>(promotions.load(std::memory_order_relaxed));
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Scheduler.h"
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// Multi-level feedback queue. Arrivals enter level 0; a process that uses its
+// whole quantum drops a level, one that sleeps climbs a level, and every
+// boost_interval ticks everything returns to level 0 so long jobs cannot
+// starve. Cores always take from the highest non-empty level.
+class MLFQScheduler : public Scheduler
+{
+public:
+    // quanta[i] is level i's time slice; the number of levels is quanta.size()
+    MLFQScheduler(int num_cores, int min_ins, int max_ins, std::vector<int> quanta, int boost_interval);
+    ~MLFQScheduler();
+
+    std::string name() const override { return "MLFQ Scheduler"; }
+
+    // Levels replace whatever ready-queue the config asked for
+    void set_ready_queue(const std::string &type, int capacity) override;
+    // Generates arrivals, then boosts every boost_interval ticks
+    void on_cpu_cycle(uint64_t cycle_number) override;
+
+    // "2,4,8" -> {2, 4, 8}; padded to levels by doubling the last quantum
+    static std::vector<int> parse_quanta(const std::string &text, int levels);
+
+protected:
+    int time_slice(const std::shared_ptr<Process> &process) const override;
+    void on_slice_expired(Process &process) override;
+    void on_wake(Process &process) override;
+
+private:
+    class LevelQueue : public ReadyQueue
+    {
+    public:
+        explicit LevelQueue(int levels);
+
+        int push(std::shared_ptr<Process> process, int core_id) override;
+        std::shared_ptr<Process> try_pop(int core_id) override;
+        size_t size() const override;
+        void collect_stats(std::map<int, std::map<std::string, float>> &stats) const override;
+
+        // Moves every queued process to level 0; the rest catch up on push
+        void boost();
+        uint64_t epoch() const { return boost_epoch.load(std::memory_order_relaxed); }
+
+        std::atomic<uint64_t> demotions{0};
+        std::atomic<uint64_t> promotions{0};
+
+    private:
+        mutable std::mutex mutex;
+        std::vector<std::deque<std::shared_ptr<Process>>> levels;
+        std::atomic<size_t> total{0};
+        std::atomic<uint64_t> boost_epoch{0};
+    };
+
+    std::vector<int> quanta;
+    int boost_interval;
+    LevelQueue *level_queue; // owned by ready_queue
+};
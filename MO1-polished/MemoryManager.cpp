@@ -0,0 +1,269 @@
+#include "MemoryManager.h"
+#include "Process.h"
+
+#include <algorithm>
+#include <cstring>
+
+MemoryManager *MemoryManager::instance = nullptr;
+
+MemoryManager *MemoryManager::getInstance()
+{
+    if (!instance)
+        instance = new MemoryManager();
+    return instance;
+}
+
+void MemoryManager::destroy()
+{
+    delete instance;
+    instance = nullptr;
+}
+
+MemoryManager::MemoryManager()
+{
+    configure(16384, 16, 4096);
+}
+
+void MemoryManager::configure(size_t total_bytes, size_t frame, size_t per_process)
+{
+    std::unique_lock<std::mutex> lock(frames_mutex);
+
+    frame_bytes = std::max<size_t>(frame, 2);
+    frame_count = std::max<size_t>(total_bytes / frame_bytes, 1);
+    // Addresses are logged as uint16, which also matches the spec's limit
+    process_bytes = std::clamp<size_t>(per_process, 2, 65536);
+
+    memory.assign(frame_count * frame_bytes, 0);
+    frames = std::make_unique<FrameInfo[]>(frame_count);
+
+    free_frames.clear();
+    // Handed out lowest first
+    for (size_t i = frame_count; i-- > 0;)
+        free_frames.push_back(static_cast<int32_t>(i));
+    clock_hand = 0;
+    used_frames = 0;
+
+    // Reopened lazily at the new page size on the first eviction
+    backing_store.close();
+}
+
+void MemoryManager::set_replacement_policy(const std::string &name)
+{
+    policy = name == "lru" ? ReplacementPolicy::LRU : ReplacementPolicy::CLOCK;
+}
+
+std::string MemoryManager::get_policy_name() const
+{
+    return policy == ReplacementPolicy::LRU ? "lru" : "clock";
+}
+
+uint8_t *MemoryManager::translate(PageTable &table, uint32_t address, bool write,
+                                  std::unique_lock<std::mutex> &lock, MemoryStatus &status)
+{
+    if (address >= process_bytes)
+    {
+        status = MemoryStatus::ACCESS_VIOLATION;
+        return nullptr;
+    }
+
+    if (table.entries.empty())
+        table.entries.resize((process_bytes + frame_bytes - 1) / frame_bytes);
+
+    uint32_t page = static_cast<uint32_t>(address / frame_bytes);
+    if (table.entries[page].frame < 0 && !page_in(table, page, lock))
+    {
+        status = MemoryStatus::OUT_OF_MEMORY;
+        return nullptr;
+    }
+
+    PageTableEntry &entry = table.entries[page];
+    FrameInfo &info = frames[entry.frame];
+    if (policy == ReplacementPolicy::LRU)
+        info.last_use.store(access_clock.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+    else if (!info.referenced.load(std::memory_order_relaxed))
+        info.referenced.store(true, std::memory_order_relaxed);
+    if (write)
+        entry.dirty = true;
+
+    status = MemoryStatus::OK;
+    return &memory[entry.frame * frame_bytes + address % frame_bytes];
+}
+
+bool MemoryManager::page_in(PageTable &table, uint32_t page, std::unique_lock<std::mutex> &lock)
+{
+    table.page_faults.fetch_add(1, std::memory_order_relaxed);
+    page_faults.fetch_add(1, std::memory_order_relaxed);
+
+    // Respect the lock order; only this core maps pages of its own table,
+    // so the entry is still non-resident once the lock is retaken
+    lock.unlock();
+    std::unique_lock<std::mutex> frames_lock(frames_mutex);
+    lock.lock();
+
+    int32_t frame = -1;
+    if (!free_frames.empty())
+    {
+        frame = free_frames.back();
+        free_frames.pop_back();
+        used_frames.fetch_add(1);
+    }
+    else
+    {
+        frame = evict(table);
+        if (frame < 0)
+            return false;
+    }
+
+    PageTableEntry &entry = table.entries[page];
+    uint8_t *data = &memory[frame * frame_bytes];
+    if (entry.swap_slot >= 0)
+    {
+        backing_store.read_page(entry.swap_slot, data);
+        entry.dirty = false;
+        table.page_ins.fetch_add(1, std::memory_order_relaxed);
+        page_ins.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        // First touch: zero-filled, and it has no swap copy yet
+        std::memset(data, 0, frame_bytes);
+        entry.dirty = true;
+    }
+
+    FrameInfo &info = frames[frame];
+    info.owner = &table;
+    info.page = page;
+    info.referenced.store(true, std::memory_order_relaxed);
+    info.last_use.store(access_clock.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+    entry.frame = frame;
+    return true;
+}
+
+int32_t MemoryManager::pick_victim()
+{
+    if (policy == ReplacementPolicy::LRU)
+    {
+        size_t oldest = 0;
+        for (size_t i = 1; i < frame_count; ++i)
+        {
+            if (frames[i].last_use.load(std::memory_order_relaxed) <
+                frames[oldest].last_use.load(std::memory_order_relaxed))
+                oldest = i;
+        }
+        return static_cast<int32_t>(oldest);
+    }
+
+    // Two sweeps at most: the first clears every referenced bit it passes
+    for (size_t step = 0; step < 2 * frame_count; ++step)
+    {
+        size_t frame = clock_hand;
+        clock_hand = (clock_hand + 1) % frame_count;
+        if (!frames[frame].referenced.exchange(false, std::memory_order_relaxed))
+            return static_cast<int32_t>(frame);
+    }
+    return static_cast<int32_t>(clock_hand);
+}
+
+int32_t MemoryManager::evict(PageTable &faulting)
+{
+    if (!backing_store.is_open() && !backing_store.open(backing_store_path, frame_bytes))
+        return -1;
+
+    int32_t frame = pick_victim();
+    FrameInfo &info = frames[frame];
+    PageTable &victim = *info.owner;
+
+    // The faulting table is already locked by this core
+    std::unique_lock<std::mutex> victim_lock(victim.mutex, std::defer_lock);
+    if (&victim != &faulting)
+        victim_lock.lock();
+
+    PageTableEntry &entry = victim.entries[info.page];
+    if (entry.dirty || entry.swap_slot < 0)
+    {
+        if (entry.swap_slot < 0)
+            entry.swap_slot = backing_store.allocate_slot();
+        if (entry.swap_slot < 0)
+            return -1;
+
+        backing_store.write_page(entry.swap_slot, &memory[frame * frame_bytes]);
+        victim.page_outs.fetch_add(1, std::memory_order_relaxed);
+        page_outs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    entry.frame = -1;
+    entry.dirty = false;
+    info.owner = nullptr;
+    return frame;
+}
+
+MemoryStatus MemoryManager::read(Process &process, uint32_t address, uint16_t &value)
+{
+    // Both bytes of the value must lie inside the address space
+    if (static_cast<uint64_t>(address) + 1 >= process_bytes)
+        return MemoryStatus::ACCESS_VIOLATION;
+
+    PageTable &table = process.page_table;
+    std::unique_lock<std::mutex> lock(table.mutex);
+    MemoryStatus status;
+
+    uint8_t *low = translate(table, address, false, lock, status);
+    if (!low)
+        return status;
+    // Paging in the high byte's page may evict the low byte's page
+    uint8_t low_byte = *low;
+
+    uint8_t *high = (address + 1) % frame_bytes != 0 ? low + 1
+                                                     : translate(table, address + 1, false, lock, status);
+    if (!high)
+        return status;
+
+    value = static_cast<uint16_t>(low_byte | (*high << 8));
+    return MemoryStatus::OK;
+}
+
+MemoryStatus MemoryManager::write(Process &process, uint32_t address, uint16_t value)
+{
+    if (static_cast<uint64_t>(address) + 1 >= process_bytes)
+        return MemoryStatus::ACCESS_VIOLATION;
+
+    PageTable &table = process.page_table;
+    std::unique_lock<std::mutex> lock(table.mutex);
+    MemoryStatus status;
+
+    uint8_t *low = translate(table, address, true, lock, status);
+    if (!low)
+        return status;
+    *low = static_cast<uint8_t>(value & 0xFF);
+
+    uint8_t *high = (address + 1) % frame_bytes != 0 ? low + 1
+                                                     : translate(table, address + 1, true, lock, status);
+    if (!high)
+        return status;
+    *high = static_cast<uint8_t>(value >> 8);
+    return MemoryStatus::OK;
+}
+
+void MemoryManager::release(Process &process)
+{
+    std::unique_lock<std::mutex> frames_lock(frames_mutex);
+    PageTable &table = process.page_table;
+    std::unique_lock<std::mutex> lock(table.mutex);
+
+    for (PageTableEntry &entry : table.entries)
+    {
+        if (entry.frame >= 0)
+        {
+            frames[entry.frame].owner = nullptr;
+            free_frames.push_back(entry.frame);
+            used_frames.fetch_sub(1);
+            entry.frame = -1;
+        }
+        if (entry.swap_slot >= 0)
+        {
+            if (backing_store.is_open())
+                backing_store.free_slot(entry.swap_slot);
+            entry.swap_slot = -1;
+        }
+    }
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BackingStore.h"
+
+class Process;
+
+enum class MemoryStatus
+{
+    OK,
+    ACCESS_VIOLATION, // address outside the process's address space
+    OUT_OF_MEMORY     // no frame could be freed to back the page
+};
+
+enum class ReplacementPolicy
+{
+    CLOCK, // second chance on a referenced bit
+    LRU    // evict the frame with the oldest access stamp
+};
+
+struct PageTableEntry
+{
+    int32_t frame = -1;     // -1 while the page is not resident
+    int32_t swap_slot = -1; // backing store copy, -1 if never paged out
+    bool dirty = false;     // resident copy differs from the swap copy
+};
+
+// Per-process page table. The owning process's core holds the mutex for
+// each access; an evicting core takes it to steal a frame.
+struct PageTable
+{
+    std::mutex mutex;
+    std::vector<PageTableEntry> entries; // sized on first access
+
+    std::atomic<uint64_t> page_faults{0};
+    std::atomic<uint64_t> page_ins{0};
+    std::atomic<uint64_t> page_outs{0};
+};
+
+// Simulated physical memory: one flat byte array cut into equal frames.
+// Every process sees mem-per-proc bytes of its own address space, paged on
+// demand onto frames. When no frame is free a victim chosen by the
+// replacement policy is written to the memory-mapped backing store and
+// paged back in on its next access. Values are uint16, stored little-endian.
+//
+// Lock order: frames_mutex, then page table mutexes. The access fast path
+// holds only its own page table's mutex and drops it before faulting.
+class MemoryManager
+{
+public:
+    static MemoryManager *getInstance();
+    static void destroy();
+
+    // Sizes in bytes. Drops every mapping, so call before processes exist.
+    void configure(size_t total_bytes, size_t frame_bytes, size_t process_bytes);
+    // "clock" or "lru"
+    void set_replacement_policy(const std::string &name);
+    void set_backing_store_path(const std::string &path) { backing_store_path = path; }
+
+    MemoryStatus read(Process &process, uint32_t address, uint16_t &value);
+    MemoryStatus write(Process &process, uint32_t address, uint16_t value);
+
+    // Returns every frame and swap slot the process holds
+    void release(Process &process);
+
+    size_t get_process_memory() const { return process_bytes; }
+    size_t get_frame_size() const { return frame_bytes; }
+    size_t get_frame_count() const { return frame_count; }
+    size_t get_used_frames() const { return used_frames.load(); }
+    std::string get_policy_name() const;
+
+    uint64_t get_page_faults() const { return page_faults.load(); }
+    uint64_t get_page_ins() const { return page_ins.load(); }
+    uint64_t get_page_outs() const { return page_outs.load(); }
+
+private:
+    MemoryManager();
+
+    struct FrameInfo
+    {
+        PageTable *owner = nullptr; // nullptr while free
+        uint32_t page = 0;
+        std::atomic<bool> referenced{false};
+        std::atomic<uint64_t> last_use{0};
+    };
+
+    // Byte backing address, paging it in if needed; nullptr on failure.
+    // lock holds table.mutex and is dropped while a fault is serviced.
+    uint8_t *translate(PageTable &table, uint32_t address, bool write,
+                       std::unique_lock<std::mutex> &lock, MemoryStatus &status);
+    bool page_in(PageTable &table, uint32_t page, std::unique_lock<std::mutex> &lock);
+    // Frees a frame by paging out a victim; frames_mutex must be held
+    int32_t evict(PageTable &faulting);
+    int32_t pick_victim();
+
+    static MemoryManager *instance;
+
+    size_t frame_bytes = 0;
+    size_t frame_count = 0;
+    size_t process_bytes = 0;
+    ReplacementPolicy policy = ReplacementPolicy::CLOCK;
+    std::vector<uint8_t> memory;
+    std::unique_ptr<FrameInfo[]> frames;
+
+    std::mutex frames_mutex;
+    std::vector<int32_t> free_frames;
+    size_t clock_hand = 0;
+    std::atomic<size_t> used_frames{0};
+    std::atomic<uint64_t> access_clock{0}; // LRU stamps
+
+    std::string backing_store_path = "csopesy-backing-store";
+    BackingStore backing_store;
+
+    std::atomic<uint64_t> page_faults{0};
+    std::atomic<uint64_t> page_ins{0};
+    std::atomic<uint64_t> page_outs{0};
+};
@@ -0,0 +1,69 @@
+#include "ParkingLot.h"
+
+#include <chrono>
+
+ParkingLot::ParkingLot(int num_cores)
+{
+    for (int i = 0; i < num_cores; ++i)
+        spots.push_back(std::make_unique<Spot>());
+}
+
+void ParkingLot::park(int core_id, const std::function<bool()> &has_work)
+{
+    Spot &spot = *spots[core_id];
+
+    spot.parked.store(true);
+    parked_count.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!has_work())
+    {
+        std::unique_lock<std::mutex> lock(spot.mutex);
+        // Timed wait is only a safety net; pushes wake us explicitly
+        spot.condition.wait_for(lock, std::chrono::milliseconds(50), [&spot]
+                                { return spot.notified; });
+        spot.notified = false;
+    }
+
+    if (spot.parked.exchange(false))
+        parked_count.fetch_sub(1);
+}
+
+void ParkingLot::unpark_one(int preferred_core)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_count.load() == 0)
+        return;
+
+    if (preferred_core >= 0 && wake(preferred_core))
+        return;
+
+    int n = static_cast<int>(spots.size());
+    int start = static_cast<int>(next_spot.fetch_add(1, std::memory_order_relaxed) % n);
+    for (int i = 0; i < n; ++i)
+    {
+        if (wake((start + i) % n))
+            return;
+    }
+}
+
+void ParkingLot::unpark_all()
+{
+    for (int i = 0; i < static_cast<int>(spots.size()); ++i)
+        wake(i);
+}
+
+bool ParkingLot::wake(int core_id)
+{
+    Spot &spot = *spots[core_id];
+    if (!spot.parked.exchange(false))
+        return false;
+
+    parked_count.fetch_sub(1);
+    {
+        std::unique_lock<std::mutex> lock(spot.mutex);
+        spot.notified = true;
+    }
+    spot.condition.notify_one();
+    return true;
+}
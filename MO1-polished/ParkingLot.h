@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Per-core parking spots for idle core threads. Producers only pay for a
+// wake-up when somebody is actually parked, instead of every push hitting a
+// shared condition variable.
+class ParkingLot
+{
+public:
+    explicit ParkingLot(int num_cores);
+
+    // Blocks core_id until unparked, unless has_work() turns true after the
+    // core has announced itself (closes the lost wake-up window)
+    void park(int core_id, const std::function<bool()> &has_work);
+
+    // Wakes preferred_core if it is parked, otherwise any parked core
+    void unpark_one(int preferred_core = -1);
+    void unpark_all();
+
+private:
+    struct alignas(64) Spot
+    {
+        std::atomic<bool> parked{false};
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool notified = false;
+    };
+
+    bool wake(int core_id);
+
+    std::vector<std::unique_ptr<Spot>> spots;
+    std::atomic<int> parked_count{0};
+    std::atomic<unsigned> next_spot{0};
+};
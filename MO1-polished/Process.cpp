@@ -1,17 +1,71 @@
 #include "Process.h"
 #include "Command.h"
 #include "ConsoleManager.h"
+#include "ProgramCache.h"
 #include <sstream>
-#include <iomanip>
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 
 Process::Process(const std::string &name, int core_id)
     : name(name), current_core(core_id), delay_per_exec(0), delay_counter(0) {}
 
-void Process::add_command(std::shared_ptr<Command> cmd)
+void Process::add_command(Command *cmd)
 {
     commands.push_back(cmd);
+    instruction_total.fetch_add(cmd->executed_length(), std::memory_order_relaxed);
+}
+
+void Process::compile()
+{
+    // Images are shared, so appending works on a private copy
+    Program image = program ? *program : Program();
+    ProgramBuilder builder(image);
+    for (Command *cmd : commands)
+    {
+        cmd->compile(builder);
+    }
+    std::atomic_store(&program, ProgramCache::intern(std::move(image)));
+
+    commands.clear();
+    commands.shrink_to_fit();
+    arena.reset();
+}
+
+void Process::advance_control_flow()
+{
+    const std::vector<Instruction> &code = program->code;
+    while (pc < code.size())
+    {
+        const Instruction &ins = code[pc];
+        if (ins.op == OpCode::FOR_BEGIN)
+        {
+            if (ins.a == 0 || loop_depth == MAX_LOOP_DEPTH)
+            {
+                pc = ins.imm + 1;
+                continue;
+            }
+            loop_stack[loop_depth++] = {static_cast<uint32_t>(pc), ins.a};
+            pc++;
+        }
+        else if (ins.op == OpCode::FOR_END)
+        {
+            LoopFrame &frame = loop_stack[loop_depth - 1];
+            if (--frame.remaining > 0)
+            {
+                pc = frame.begin + 1;
+            }
+            else
+            {
+                loop_depth--;
+                pc++;
+            }
+        }
+        else
+        {
+            return;
+        }
+    }
 }
 
 void Process::execute(int core_id)
@@ -19,7 +73,6 @@ void Process::execute(int core_id)
     if (is_finished)
         return;
 
-    current_core = core_id;
     if (!ConsoleManager::getInstance()->isRunning()) // or custom global flag
         return;
 
@@ -35,32 +88,225 @@ void Process::execute(int core_id)
         return;
     }
 
-    if (current_command_index >= commands.size())
+    if (!program || !commands.empty())
+        compile();
+
+    advance_control_flow();
+    if (pc >= program->code.size())
     {
-        is_finished = true;
-        finish_time = std::chrono::system_clock::now();
-        log_execution(core_id, "Process " + name + " has completed all its commands.");
+        retire();
+        log_event(LogKind::FINISHED, core_id);
         return;
     }
 
-    commands[current_command_index]->execute(this, core_id, name);
-    current_command_index++;
+    pc = run_instruction(pc, core_id);
+    // Single writer; relaxed is enough for the concurrent readers
+    current_command_index.store(current_command_index.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
     delay_counter = delay_per_exec;
 }
 
-uint16_t Process::get_var(const std::string &var_name)
+size_t Process::run_instruction(size_t at, int core_id)
 {
-    auto it = variables.find(var_name);
-    if (it == variables.end())
+    const Instruction &ins = program->code[at];
+
+    switch (ins.op)
+    {
+    case OpCode::PRINT:
+        log_event(LogKind::PRINT, core_id, ins.a);
+        break;
+
+    case OpCode::PRINT_VAR:
+        log_event(LogKind::PRINT_VAR, core_id, ins.a, read_slot(ins.b));
+        break;
+
+    case OpCode::DECLARE:
+        write_slot(ins.a, ins.b);
+        break;
+
+    case OpCode::ADD:
+    case OpCode::SUBTRACT:
     {
-        return 0;
+        int32_t a = (ins.flags & OPERAND_B_IS_VAR) ? read_slot(ins.b) : ins.b;
+        int32_t b = (ins.flags & OPERAND_C_IS_VAR) ? read_slot(ins.c) : ins.c;
+        int32_t result = ins.op == OpCode::ADD ? a + b : a - b;
+        // uint16 saturates at both ends
+        if (result > 65535)
+            result = 65535;
+        if (result < 0)
+            result = 0;
+        write_slot(ins.a, static_cast<uint16_t>(result));
+        break;
     }
-    return it->second;
+
+    case OpCode::SLEEP:
+        // Non-blocking: the core loop sees WAITING, releases the core and
+        // hands the process to the scheduler's timer wheel
+        sleep_until(ConsoleManager::getCpuCycles() + ins.imm);
+        break;
+
+    case OpCode::READ:
+    {
+        uint16_t value = 0;
+        MemoryStatus status = MemoryManager::getInstance()->read(*this, ins.imm, value);
+        if (status != MemoryStatus::OK)
+            terminate(core_id, status, ins.imm);
+        else
+            write_slot(ins.a, value);
+        break;
+    }
+
+    case OpCode::WRITE:
+    {
+        uint16_t value = (ins.flags & OPERAND_B_IS_VAR) ? read_slot(ins.b) : ins.b;
+        MemoryStatus status = MemoryManager::getInstance()->write(*this, ins.imm, value);
+        if (status != MemoryStatus::OK)
+            terminate(core_id, status, ins.imm);
+        break;
+    }
+
+    case OpCode::FOR_BEGIN:
+    case OpCode::FOR_END:
+        // Handled by advance_control_flow
+        break;
+    }
+
+    return at + 1;
+}
+
+void Process::retire()
+{
+    is_finished = true;
+    state = ProcessState::FINISHED;
+    finish_time = std::chrono::system_clock::now();
+    MemoryManager::getInstance()->release(*this);
+
+    commands.clear();
+    commands.shrink_to_fit();
+    arena.reset();
+}
+
+void Process::terminate(int core_id, MemoryStatus status, uint32_t address)
+{
+    retire();
+    log_event(status == MemoryStatus::OUT_OF_MEMORY ? LogKind::OUT_OF_MEMORY : LogKind::MEMORY_VIOLATION,
+              core_id, 0, static_cast<uint16_t>(std::min<uint32_t>(address, 0xFFFF)));
+}
+
+void Process::log_event(LogKind kind, int core_id, uint16_t message, uint16_t value)
+{
+    logs.push({ConsoleManager::getCpuCycles(), std::time(nullptr), static_cast<int16_t>(core_id),
+               kind, message, value});
+}
+
+std::string Process::format_log(const LogRecord &record, const Program &image) const
+{
+    std::tm tm = *std::localtime(&record.wall_time);
+    char timestamp[20];
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &tm);
+
+    std::ostringstream oss;
+    oss << "(" << timestamp << ") Core:" << record.core << " Tick:" << record.tick << " - ";
+    switch (record.kind)
+    {
+    case LogKind::PRINT:
+        oss << "PRINT(\"" << with_name(image.strings[record.message]) << "\")";
+        break;
+    case LogKind::PRINT_VAR:
+        oss << "PRINT(\"" << with_name(image.strings[record.message]) << record.value << "\")";
+        break;
+    case LogKind::FINISHED:
+        oss << "Process " << name << " has completed all its commands.";
+        break;
+    case LogKind::MEMORY_VIOLATION:
+        oss << "Memory access violation at 0x" << std::hex << std::uppercase << record.value
+            << ". Process " << name << " terminated.";
+        break;
+    case LogKind::OUT_OF_MEMORY:
+        oss << "Out of memory mapping 0x" << std::hex << std::uppercase << record.value
+            << ". Process " << name << " terminated.";
+        break;
+    }
+    return oss.str();
+}
+
+std::string Process::with_name(const std::string &text) const
+{
+    std::string result = text;
+    size_t token_length = std::char_traits<char>::length(PROCESS_NAME_TOKEN);
+    for (size_t at = result.find(PROCESS_NAME_TOKEN); at != std::string::npos;
+         at = result.find(PROCESS_NAME_TOKEN, at + name.size()))
+        result.replace(at, token_length, name);
+    return result;
+}
+
+void Process::write_slot(uint16_t slot, uint16_t value)
+{
+    if (slot >= MAX_VARIABLES)
+        return;
+    variables[slot].store(value, std::memory_order_relaxed);
+    // Single writer, so no read-modify-write is needed
+    uint32_t written = written_slots.load(std::memory_order_relaxed);
+    if (!(written & (1u << slot)))
+        written_slots.store(written | (1u << slot), std::memory_order_relaxed);
+}
+
+uint16_t Process::slot_of(const std::string &var_name) const
+{
+    std::shared_ptr<const Program> image = current_program();
+    if (!image)
+        return NO_SLOT;
+
+    const auto &symbols = image->symbols;
+    auto it = std::find(symbols.begin(), symbols.end(), var_name);
+    return it == symbols.end() ? NO_SLOT : static_cast<uint16_t>(it - symbols.begin());
+}
+
+uint16_t Process::get_var(const std::string &var_name)
+{
+    return read_slot(slot_of(var_name));
 }
 
 void Process::set_var(const std::string &var_name, uint16_t value)
 {
-    variables[var_name] = value;
+    write_slot(slot_of(var_name), value);
+}
+
+std::vector<std::pair<std::string, uint16_t>> Process::getVariables() const
+{
+    std::vector<std::pair<std::string, uint16_t>> result;
+    std::shared_ptr<const Program> image = current_program();
+    if (!image)
+        return result;
+
+    uint32_t written = written_slots.load(std::memory_order_relaxed);
+    for (size_t slot = 0; slot < image->symbols.size(); ++slot)
+    {
+        if (written & (1u << slot))
+            result.emplace_back(image->symbols[slot], variables[slot].load(std::memory_order_relaxed));
+    }
+    return result;
+}
+
+void Process::sleep_until(uint64_t tick)
+{
+    wake_tick = tick;
+    state = ProcessState::WAITING;
+}
+
+std::string Process::getStateName() const
+{
+    switch (state.load())
+    {
+    case ProcessState::READY:
+        return "Ready";
+    case ProcessState::RUNNING:
+        return "Running";
+    case ProcessState::WAITING:
+        return "Waiting";
+    case ProcessState::FINISHED:
+        return "Finished";
+    }
+    return "Unknown";
 }
 
 bool Process::can_execute()
@@ -78,22 +324,8 @@ bool Process::can_execute()
 
 size_t Process::get_instruction_count() const
 {
-    return commands.size();
-}
-
-void Process::log_execution(int core_id, const std::string &message)
-{
-    auto now = std::chrono::system_clock::now();
-    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
-    std::tm tm = *std::localtime(&now_c);
-
-    char timestamp[20];
-    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &tm);
-
-    std::ostringstream oss;
-    oss << "(" << timestamp << ") Core:" << core_id << " - " << message;
-
-    logs.push_back(oss.str());
+    // Loops expanded, so it matches the per-tick current_command_index
+    return instruction_total.load(std::memory_order_relaxed);
 }
 
 // --- Getters ---
@@ -101,7 +333,19 @@ std::string Process::getName() const { return name; }
 bool Process::isFinished() const { return is_finished; }
 bool Process::hasStarted() const { return has_started; }
 int Process::getCurrentCore() const { return current_core; }
-int Process::getCurrentCommandIndex() const { return current_command_index; }
+int Process::getCurrentCommandIndex() const { return current_command_index.load(std::memory_order_relaxed); }
 std::chrono::system_clock::time_point Process::getStartTime() const { return start_time; }
 std::chrono::system_clock::time_point Process::getFinishTime() const { return finish_time; }
-const std::vector<std::string> &Process::getLogs() const { return logs; }
+
+std::vector<std::string> Process::getLogs() const
+{
+    std::vector<std::string> lines;
+    std::shared_ptr<const Program> image = current_program();
+    if (!image)
+        return lines;
+
+    lines.reserve(logs.size());
+    logs.for_each([&](const LogRecord &record)
+                  { lines.push_back(format_log(record, *image)); });
+    return lines;
+}
@@ -2,52 +2,153 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <array>
 #include <memory>
 #include <chrono>
+#include <atomic>
+#include <cstdint>
+
+#include "Bytecode.h"
+#include "ProcessLog.h"
+#include "MemoryManager.h"
+#include "Arena.h"
 
 class Command;
+class ProcessRegistry;
+
+enum class ProcessState
+{
+    READY,
+    RUNNING,
+    WAITING, // sleeping until wake_tick; holds no core
+    FINISHED
+};
 
 class Process
 {
 public:
     std::string name;
+    int pid = 0; // assigned by ProcessRegistry::add
+    std::atomic<ProcessState> state{ProcessState::READY};
+    uint64_t wake_tick = 0;
     bool is_finished = false;
     bool has_started = false;
-    int current_command_index = 0;
-    int current_core = -1; // Default unless set via constructor
+    // Written only by the core running the process; read by SRTF's tick-time
+    // preemption check and the console while it runs
+    std::atomic<int> current_command_index{0};
+    std::atomic<int> current_core{-1}; // core holding the process, -1 when it holds none
 
     std::chrono::system_clock::time_point start_time;
     std::chrono::system_clock::time_point finish_time;
 
-    std::vector<std::shared_ptr<Command>> commands;
-    std::vector<std::string> logs;
+    Arena arena;                     // owns commands; freed once they are compiled
+    std::vector<Command *> commands; // front end, not yet lowered into program
+    std::shared_ptr<const Program> program; // shared image, see ProgramCache
+    PageTable page_table; // maintained by MemoryManager
+
+    // Bookkeeping for the scheduling policy; only touched at hand-offs, when
+    // no core or queue is working on the process. Progress while running is
+    // read from current_command_index instead.
+    struct SchedulingInfo
+    {
+        int level = 0;            // MLFQ queue, 0 = highest priority
+        uint64_t boost_epoch = 0; // last MLFQ boost applied
+        int nice = 0;             // -20 (heaviest) .. 19, from screen -s -nice
+        uint64_t vruntime = 0;    // CFS weighted ticks
+        int slice = 0;            // ticks granted at dispatch, if the policy sizes them then
+        uint64_t relative_deadline = 0; // ticks allowed after admission; 0 = best effort
+        uint64_t deadline = 0;          // absolute tick, set by Scheduler::add_process
+        uint32_t tickets = 0;           // proportional share; 0 = from ticket-groups
+        int share_group = -1;           // ticket group, assigned on first queueing
+        uint64_t pass = 0;              // stride scheduling position
+    };
+    SchedulingInfo sched;
 
     Process(const std::string &name, int core_id = -1); // updated constructor
 
-    void add_command(std::shared_ptr<Command> cmd);
+    // cmd must live in this process's arena
+    void add_command(Command *cmd);
     void execute(int core_id);
 
+    // Name-based access for debugging; instructions use slots directly
     uint16_t get_var(const std::string &var_name);
     void set_var(const std::string &var_name, uint16_t value);
+    // Every variable written so far as (name, value), in slot order
+    std::vector<std::pair<std::string, uint16_t>> getVariables() const;
 
     size_t get_instruction_count() const;
     bool can_execute();
+    void set_delay_per_exec(int delay) { delay_per_exec = delay; }
+    void set_log_capacity(size_t capacity) { logs.set_capacity(capacity); }
 
-    void log_execution(int core_id, const std::string &message);
+    // SLEEP: give up the core until cpu_cycles reaches tick
+    void sleep_until(uint64_t tick);
+    bool isWaiting() const { return state == ProcessState::WAITING; }
+    ProcessState getState() const { return state; }
+    std::string getStateName() const;
 
     // Getters
     std::string getName() const;
+    int getPid() const { return pid; }
     bool isFinished() const;
     bool hasStarted() const;
     int getCurrentCore() const;
     int getCurrentCommandIndex() const;
     std::chrono::system_clock::time_point getStartTime() const;
     std::chrono::system_clock::time_point getFinishTime() const;
-    const std::vector<std::string> &getLogs() const;
+    // Formats the retained log records, oldest first
+    std::vector<std::string> getLogs() const;
+    uint64_t getDroppedLogCount() const { return logs.dropped(); }
 
 private:
+    friend class ProcessRegistry;
+
+    // Lowers pending commands onto a copy of program and swaps in the
+    // deduplicated image; the commands and their arena are then dropped
+    void compile();
+    // Program image for threads other than the one running the process
+    std::shared_ptr<const Program> current_program() const { return std::atomic_load(&program); }
+    // Moves pc past FOR_BEGIN/FOR_END, entering and repeating loops; these
+    // cost no tick so every tick lands on a real instruction
+    void advance_control_flow();
+    // Runs the non-control instruction at pc; returns the next pc
+    size_t run_instruction(size_t pc, int core_id);
+    // Marks the process finished and frees its memory and any pending commands
+    void retire();
+    // Ends the process after a failed memory access
+    void terminate(int core_id, MemoryStatus status, uint32_t address);
+    void log_event(LogKind kind, int core_id, uint16_t message = 0, uint16_t value = 0);
+    std::string format_log(const LogRecord &record, const Program &image) const;
+    // Substitutes PROCESS_NAME_TOKEN
+    std::string with_name(const std::string &text) const;
+
+    struct LoopFrame
+    {
+        uint32_t begin;     // index of the FOR_BEGIN
+        uint16_t remaining; // iterations left, including the current one
+    };
+
+    size_t pc = 0;
+    std::array<LoopFrame, MAX_LOOP_DEPTH> loop_stack{};
+    int loop_depth = 0;
+    std::atomic<size_t> instruction_total{0}; // loops expanded
+    LogRing logs;
     int delay_per_exec = 0;
     int delay_counter = 0;
-    std::map<std::string, uint16_t> variables;
+    uint16_t read_slot(uint16_t slot) const
+    {
+        return slot < MAX_VARIABLES ? variables[slot].load(std::memory_order_relaxed) : 0;
+    }
+    void write_slot(uint16_t slot, uint16_t value);
+    uint16_t slot_of(const std::string &var_name) const;
+
+    // Written only by the core running the process; relaxed atomics so
+    // process-smi can read them while it runs
+    std::array<std::atomic<uint16_t>, MAX_VARIABLES> variables{};
+    std::atomic<uint32_t> written_slots{0}; // bit per slot
+
+    // Intrusive links for ProcessRegistry's per-state lists; guarded by its mutex
+    Process *state_prev = nullptr;
+    Process *state_next = nullptr;
+    ProcessState listed_state = ProcessState::READY;
 };
@@ -1,76 +1,94 @@
 #include "ProcessFactory.h"
 #include "Command.h"
+#include "MemoryManager.h"
+#include "ProcessPool.h"
 
-#include <random>
 #include <sstream>
 
-std::shared_ptr<Process> ProcessFactory::generate_dummy_process(const std::string &name, int min_ins, int max_ins)
+namespace
 {
-    auto process = std::make_shared<Process>(name);
+    // Variable pools per instruction kind
+    const char *const PRINT_VARS[] = {"x", "y", "result", "temp", "value"};
+    const char *const ARITHMETIC_VARS[] = {"a", "b", "c", "temp", "sum", "diff"};
+    const char *const DECLARE_VARS[] = {"a1", "b1", "c1", "temp1", "varX", "tempVar"};
+    const char *const MEMORY_VARS[] = {"a", "b", "c", "x", "y"};
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> ins_dist(min_ins, max_ins);
-    std::uniform_int_distribution<> op_dist(0, 5);
+    template <size_t N>
+    const char *pick(const char *const (&vars)[N], WorkloadRng &gen)
+    {
+        return vars[gen() % N];
+    }
+}
+
+uint64_t ProcessFactory::stream_seed(uint64_t workload_seed, uint64_t index)
+{
+    // Two rounds decorrelate neighbouring indices
+    WorkloadRng mix(workload_seed ^ (index * 0xD1B54A32D192ED03ULL));
+    mix();
+    return mix();
+}
+
+std::shared_ptr<Process> ProcessFactory::generate_dummy_process(const std::string &name, int min_ins, int max_ins,
+                                                                uint64_t stream_seed)
+{
+    auto process = ProcessPool::make(name);
+    Arena &arena = process->arena;
+
+    WorkloadRng gen(stream_seed);
+    // READ/WRITE stay inside the address space; a uint16 needs two bytes
+    int max_addr = static_cast<int>(MemoryManager::getInstance()->get_process_memory() - 2);
 
-    int instruction_count = ins_dist(gen);
+    int instruction_count = gen.between(min_ins, max_ins);
+    process->commands.reserve(instruction_count);
 
     for (int i = 0; i < instruction_count; ++i)
     {
-        int op = op_dist(gen);
+        int op = gen.between(0, 7);
         switch (op)
         {
         case 0:
         {
-            std::uniform_int_distribution<> msg_type(0, 1);
-            std::vector<std::string> vars = {"x", "y", "result", "temp", "value"};
-            std::string message = (msg_type(gen) == 0)
-                                      ? "Hello world from " + name + "!"
-                                      : "\"Value from: \" + " + vars[gen() % vars.size()];
-            process->add_command(std::make_shared<PrintCommand>(message));
+            std::string message = (gen.between(0, 1) == 0)
+                                      ? "Hello world from " + std::string(PROCESS_NAME_TOKEN) + "!"
+                                      : std::string("\"Value from: \" + ") + pick(PRINT_VARS, gen);
+            process->add_command(arena.create<PrintCommand>(message));
             break;
         }
         case 1:
         case 2:
         {
-            std::vector<std::string> vars = {"a", "b", "c", "temp", "sum", "diff"};
-            std::string target = vars[gen() % vars.size()];
-            std::string op1 = vars[gen() % vars.size()];
-            std::string op2 = vars[gen() % vars.size()];
+            std::string target = pick(ARITHMETIC_VARS, gen);
+            std::string op1 = pick(ARITHMETIC_VARS, gen);
+            std::string op2 = pick(ARITHMETIC_VARS, gen);
             bool op1_is_var = gen() % 2;
             bool op2_is_var = gen() % 2;
-            std::uniform_int_distribution<uint16_t> val_dist(1, 500);
-            uint16_t val1 = val_dist(gen), val2 = val_dist(gen);
+            uint16_t val1 = static_cast<uint16_t>(gen.between(1, 500));
+            uint16_t val2 = static_cast<uint16_t>(gen.between(1, 500));
             if (op == 1)
-                process->add_command(std::make_shared<AddCommand>(target, op1, op2, op1_is_var, op2_is_var, val1, val2));
+                process->add_command(arena.create<AddCommand>(target, op1, op2, op1_is_var, op2_is_var, val1, val2));
             else
-                process->add_command(std::make_shared<SubtractCommand>(target, op1, op2, op1_is_var, op2_is_var, val1, val2));
+                process->add_command(arena.create<SubtractCommand>(target, op1, op2, op1_is_var, op2_is_var, val1, val2));
             break;
         }
         case 3:
         {
-            std::vector<std::string> vars = {"a1", "b1", "c1", "temp1", "varX", "tempVar"};
-            std::string var = vars[gen() % vars.size()];
-            std::uniform_int_distribution<uint16_t> val_dist(0, 1000);
-            uint16_t value = val_dist(gen);
-            process->add_command(std::make_shared<DeclareCommand>(var, value));
+            std::string var = pick(DECLARE_VARS, gen);
+            uint16_t value = static_cast<uint16_t>(gen.between(0, 1000));
+            process->add_command(arena.create<DeclareCommand>(var, value));
             break;
         }
         case 4:
         {
-            std::uniform_int_distribution<> rep_dist(2, 5);
-            int repeats = rep_dist(gen);
-            std::vector<std::shared_ptr<Command>> nested_cmds;
-            std::uniform_int_distribution<> nested_len_dist(1, 3);
-            int nested_instruction_count = nested_len_dist(gen);
-            std::uniform_int_distribution<> nested_op_dist(0, 3);
+            int repeats = gen.between(2, 5);
+            int nested_instruction_count = gen.between(1, 3);
+            Command **nested_cmds = arena.allocate_array<Command *>(nested_instruction_count);
             for (int j = 0; j < nested_instruction_count; ++j)
             {
-                int inner_op = nested_op_dist(gen);
+                int inner_op = gen.between(0, 3);
                 switch (inner_op)
                 {
                 case 0:
-                    nested_cmds.push_back(std::make_shared<PrintCommand>("\"Loop message " + std::to_string(j) + "\""));
+                    nested_cmds[j] = arena.create<PrintCommand>("\"Loop message " + std::to_string(j) + "\"");
                     break;
                 case 1:
                 {
@@ -78,35 +96,48 @@ std::shared_ptr<Process> ProcessFactory::generate_dummy_process(const std::strin
                     std::string op1 = "a" + std::to_string(j);
                     std::string op2 = "b" + std::to_string(j);
                     uint16_t val2 = gen() % 50 + 1;
-                    nested_cmds.push_back(std::make_shared<AddCommand>(target, op1, op2, true, false, 0, val2));
+                    nested_cmds[j] = arena.create<AddCommand>(target, op1, op2, true, false, 0, val2);
                     break;
                 }
                 case 2:
                 {
                     std::string var = "d" + std::to_string(j);
                     uint16_t val = gen() % 100;
-                    nested_cmds.push_back(std::make_shared<DeclareCommand>(var, val));
+                    nested_cmds[j] = arena.create<DeclareCommand>(var, val);
                     break;
                 }
                 case 3:
-                    nested_cmds.push_back(std::make_shared<SleepCommand>(1));
+                    nested_cmds[j] = arena.create<SleepCommand>(1);
                     break;
                 }
             }
-            process->add_command(std::make_shared<ForCommand>(nested_cmds, repeats));
+            process->add_command(arena.create<ForCommand>(nested_cmds, nested_instruction_count, repeats));
             break;
         }
         case 5:
         {
-            std::uniform_int_distribution<uint8_t> sleep_ticks(10, 100);
-            uint8_t ticks = sleep_ticks(gen);
-            process->add_command(std::make_shared<SleepCommand>(ticks));
+            uint8_t ticks = static_cast<uint8_t>(gen.between(10, 100));
+            process->add_command(arena.create<SleepCommand>(ticks));
             break;
         }
-        default:
-            process->add_command(std::make_shared<PrintCommand>("\"Unknown operation fallback from " + name + "\""));
+        case 6:
+        {
+            // Draws are sequenced explicitly; argument evaluation order is unspecified
+            const char *var = pick(MEMORY_VARS, gen);
+            uint32_t address = static_cast<uint32_t>(gen.between(0, max_addr));
+            process->add_command(arena.create<ReadCommand>(var, address));
             break;
         }
+        case 7:
+        {
+            const char *var = pick(MEMORY_VARS, gen);
+            bool is_var = gen() % 2;
+            uint32_t address = static_cast<uint32_t>(gen.between(0, max_addr));
+            uint16_t value = static_cast<uint16_t>(gen.between(0, 1000));
+            process->add_command(arena.create<WriteCommand>(address, var, is_var, value));
+            break;
+        }
+        }
     }
 
     return process;
@@ -1,11 +1,51 @@
 #pragma once
 
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include "Process.h"
 
+// SplitMix64. One word of state, so every process can get its own stream
+// for the cost of a multiply, and a stream depends only on its seed.
+class WorkloadRng
+{
+public:
+    using result_type = uint64_t;
+
+    explicit WorkloadRng(uint64_t seed) : state(seed) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Inclusive range; an empty or inverted range yields lo. Used instead of
+    // <random> distributions, whose output differs between standard libraries.
+    int between(int lo, int hi)
+    {
+        if (hi <= lo)
+            return lo;
+        uint64_t span = static_cast<uint64_t>(static_cast<int64_t>(hi) - lo) + 1;
+        return static_cast<int>(lo + static_cast<int64_t>((*this)() % span));
+    }
+
+private:
+    uint64_t state;
+};
+
 class ProcessFactory
 {
 public:
-    static std::shared_ptr<Process> generate_dummy_process(const std::string &name, int min_ins, int max_ins);
+    // Same stream_seed, same program
+    static std::shared_ptr<Process> generate_dummy_process(const std::string &name, int min_ins, int max_ins,
+                                                           uint64_t stream_seed);
+    // Independent stream for the index-th process of a workload seed
+    static uint64_t stream_seed(uint64_t workload_seed, uint64_t index);
 };
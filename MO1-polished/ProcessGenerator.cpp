@@ -0,0 +1,85 @@
+#include "ProcessGenerator.h"
+#include "Process.h"
+
+#include <algorithm>
+
+ProcessGenerator::ProcessGenerator(Builder build, int threads, size_t capacity)
+    : build(std::move(build)), num_threads(std::max(threads, 1)),
+      capacity(std::max<size_t>(capacity, 1)), slots(this->capacity)
+{
+}
+
+ProcessGenerator::~ProcessGenerator()
+{
+    stop();
+}
+
+void ProcessGenerator::start()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (running)
+        return;
+    running = true;
+    for (int i = 0; i < num_threads; ++i)
+        workers.emplace_back(&ProcessGenerator::worker_loop, this);
+}
+
+void ProcessGenerator::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        running = false;
+    }
+    slot_free.notify_all();
+    slot_filled.notify_all();
+
+    for (auto &worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    workers.clear();
+}
+
+void ProcessGenerator::worker_loop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        slot_free.wait(lock, [this]
+                       { return !running || next_claim < next_take + capacity; });
+        if (!running)
+            return;
+
+        uint64_t index = next_claim++;
+        lock.unlock();
+        // A claimed index is always finished, even across stop(), so the
+        // sequence has no holes when the generator restarts
+        std::shared_ptr<Process> process = build(index);
+        lock.lock();
+
+        slots[index % capacity] = std::move(process);
+        slot_filled.notify_all();
+    }
+}
+
+std::shared_ptr<Process> ProcessGenerator::take()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    std::shared_ptr<Process> &slot = slots[next_take % capacity];
+    slot_filled.wait(lock, [&]
+                     { return slot || !running; });
+    if (!slot)
+        return nullptr;
+
+    std::shared_ptr<Process> process = std::move(slot);
+    next_take++;
+    slot_free.notify_one();
+    return process;
+}
+
+size_t ProcessGenerator::buffered()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    return static_cast<size_t>(next_claim - next_take);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Process;
+
+// Builds processes ahead of demand on background threads. Process k is
+// always built by build(k) and take() hands them out strictly in index
+// order, so the workload does not depend on thread timing. Workers stay at
+// most `capacity` processes ahead of the consumer.
+class ProcessGenerator
+{
+public:
+    using Builder = std::function<std::shared_ptr<Process>(uint64_t index)>;
+
+    ProcessGenerator(Builder build, int threads, size_t capacity);
+    ~ProcessGenerator();
+
+    // Workers resume from the next unclaimed index
+    void start();
+    // Joins the workers; processes already built stay buffered
+    void stop();
+
+    // Next process in index order; waits while its worker is still building
+    // it. nullptr once stopped with nothing left for this index.
+    std::shared_ptr<Process> take();
+
+    size_t buffered();
+
+private:
+    void worker_loop();
+
+    Builder build;
+    int num_threads;
+    size_t capacity;
+
+    std::mutex mutex;
+    std::condition_variable slot_free;
+    std::condition_variable slot_filled;
+    std::vector<std::shared_ptr<Process>> slots; // index % capacity
+    uint64_t next_claim = 0;                     // next index a worker builds
+    uint64_t next_take = 0;                      // next index take() returns
+    bool running = false;
+    std::vector<std::thread> workers;
+};
@@ -0,0 +1,69 @@
+#include "ProcessLog.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<LogRecord>::value, "LogRecord is copied word by word");
+
+LogRing::LogRing(size_t capacity) : capacity(std::max<size_t>(capacity, 1)) {}
+
+void LogRing::set_capacity(size_t new_capacity)
+{
+    if (written.load(std::memory_order_relaxed) == 0)
+        capacity = std::max<size_t>(new_capacity, 1);
+}
+
+void LogRing::push(const LogRecord &record)
+{
+    uint64_t index = written.load(std::memory_order_relaxed);
+    if (!slots)
+        slots = std::make_unique<Slot[]>(capacity);
+
+    uint64_t words[RECORD_WORDS] = {};
+    std::memcpy(words, &record, sizeof(LogRecord));
+
+    Slot &slot = slots[index % capacity];
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t w = 0; w < RECORD_WORDS; ++w)
+        slot.words[w].store(words[w], std::memory_order_relaxed);
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+    // Publishes the buffer and the record to readers
+    written.store(index + 1, std::memory_order_release);
+}
+
+void LogRing::for_each(const std::function<void(const LogRecord &)> &visit) const
+{
+    uint64_t end = written.load(std::memory_order_acquire);
+    uint64_t begin = end > capacity ? end - capacity : 0;
+    for (uint64_t i = begin; i < end; ++i)
+    {
+        const Slot &slot = slots[i % capacity];
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq != 2 * i + 2)
+            continue; // already being replaced by a newer record
+
+        uint64_t words[RECORD_WORDS];
+        for (size_t w = 0; w < RECORD_WORDS; ++w)
+            words[w] = slot.words[w].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq)
+            continue;
+
+        LogRecord record;
+        std::memcpy(&record, words, sizeof(LogRecord));
+        visit(record);
+    }
+}
+
+size_t LogRing::size() const
+{
+    return static_cast<size_t>(std::min<uint64_t>(written.load(std::memory_order_acquire), capacity));
+}
+
+uint64_t LogRing::dropped() const
+{
+    uint64_t total = written.load(std::memory_order_acquire);
+    return total > capacity ? total - capacity : 0;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+
+enum class LogKind : uint8_t
+{
+    PRINT,     // message = program string
+    PRINT_VAR, // message = program string, value appended
+    FINISHED,  // process ran out of instructions
+    MEMORY_VIOLATION, // value = faulting address; process terminated
+    OUT_OF_MEMORY     // value = faulting address; process terminated
+};
+
+// One log line in binary form; text is only built when someone reads it
+struct LogRecord
+{
+    uint64_t tick;
+    std::time_t wall_time;
+    int16_t core;
+    LogKind kind;
+    uint16_t message;
+    uint16_t value;
+};
+
+// Fixed-capacity per-process log that keeps the newest records. One writer
+// (the core running the process); each slot carries a sequence number so a
+// reader skips a record that is being replaced instead of copying it torn.
+class LogRing
+{
+public:
+    explicit LogRing(size_t capacity = DEFAULT_CAPACITY);
+
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+
+    // Only valid before the first push
+    void set_capacity(size_t capacity);
+    size_t get_capacity() const { return capacity; }
+
+    void push(const LogRecord &record);
+
+    // Visits the retained records, oldest first; records overwritten while
+    // visiting are skipped
+    void for_each(const std::function<void(const LogRecord &)> &visit) const;
+
+    size_t size() const;
+    // Records overwritten because the ring was full
+    uint64_t dropped() const;
+
+private:
+    static constexpr size_t RECORD_WORDS = (sizeof(LogRecord) + 7) / 8;
+
+    // Seqlock slot: seq is 2 * index + 1 while record `index` is being
+    // written and 2 * index + 2 once it is complete
+    struct Slot
+    {
+        std::atomic<uint64_t> seq{0};
+        std::atomic<uint64_t> words[RECORD_WORDS];
+    };
+
+    size_t capacity;
+    std::unique_ptr<Slot[]> slots; // allocated on first push
+    std::atomic<uint64_t> written{0};
+};
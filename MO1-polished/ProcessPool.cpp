@@ -0,0 +1,90 @@
+#include "ProcessPool.h"
+#include "Process.h"
+
+#include <cstddef>
+#include <new>
+
+std::mutex ProcessPool::pool_mutex;
+size_t ProcessPool::block_bytes = 0;
+std::vector<void *> ProcessPool::free_blocks;
+unsigned char *ProcessPool::slab_cursor = nullptr;
+size_t ProcessPool::slab_remaining = 0;
+std::vector<std::unique_ptr<unsigned char[]>> ProcessPool::slab_storage;
+std::atomic<uint64_t> ProcessPool::slabs{0};
+std::atomic<uint64_t> ProcessPool::live{0};
+std::atomic<uint64_t> ProcessPool::reused{0};
+
+namespace
+{
+    // Routes allocate_shared's single combined allocation to the pool
+    template <typename T>
+    struct PoolAllocator
+    {
+        using value_type = T;
+
+        PoolAllocator() = default;
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U> &) {}
+
+        T *allocate(size_t n) { return static_cast<T *>(ProcessPool::allocate_block(n * sizeof(T))); }
+        void deallocate(T *p, size_t n) { ProcessPool::free_block(p, n * sizeof(T)); }
+
+        template <typename U>
+        bool operator==(const PoolAllocator<U> &) const { return true; }
+        template <typename U>
+        bool operator!=(const PoolAllocator<U> &) const { return false; }
+    };
+}
+
+std::shared_ptr<Process> ProcessPool::make(const std::string &name)
+{
+    return std::allocate_shared<Process>(PoolAllocator<Process>(), name);
+}
+
+void *ProcessPool::allocate_block(size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    if (block_bytes == 0)
+    {
+        // Keep every block suitably aligned for the next one in the slab
+        size_t align = alignof(std::max_align_t);
+        block_bytes = (bytes + align - 1) / align * align;
+    }
+    if (bytes > block_bytes)
+        return ::operator new(bytes);
+
+    live.fetch_add(1, std::memory_order_relaxed);
+    if (!free_blocks.empty())
+    {
+        void *block = free_blocks.back();
+        free_blocks.pop_back();
+        reused.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    if (slab_remaining == 0)
+    {
+        slab_storage.emplace_back(new unsigned char[block_bytes * BLOCKS_PER_SLAB]);
+        slabs.fetch_add(1, std::memory_order_relaxed);
+        slab_cursor = slab_storage.back().get();
+        slab_remaining = BLOCKS_PER_SLAB;
+    }
+
+    void *block = slab_cursor;
+    slab_cursor += block_bytes;
+    slab_remaining--;
+    return block;
+}
+
+void ProcessPool::free_block(void *block, size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    if (bytes > block_bytes)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    free_blocks.push_back(block);
+    live.fetch_sub(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Process;
+
+// Slab allocator for Process objects. make() uses allocate_shared, so the
+// Process and its shared_ptr control block share one fixed-size block;
+// blocks come from 64-block slabs and go back on a free list when the last
+// reference drops, to be reused by later generations.
+class ProcessPool
+{
+public:
+    static std::shared_ptr<Process> make(const std::string &name);
+
+    static uint64_t get_slabs() { return slabs.load(std::memory_order_relaxed); }
+    static uint64_t get_live() { return live.load(std::memory_order_relaxed); }
+    static uint64_t get_reused() { return reused.load(std::memory_order_relaxed); }
+
+    static void *allocate_block(size_t bytes);
+    static void free_block(void *block, size_t bytes);
+
+private:
+    static constexpr size_t BLOCKS_PER_SLAB = 64;
+
+    static std::mutex pool_mutex;
+    static size_t block_bytes; // fixed by the first allocation
+    static std::vector<void *> free_blocks; // returned blocks, reused first
+    static unsigned char *slab_cursor;      // next never-used block
+    static size_t slab_remaining;
+    static std::vector<std::unique_ptr<unsigned char[]>> slab_storage;
+
+    static std::atomic<uint64_t> slabs;
+    static std::atomic<uint64_t> live;
+    static std::atomic<uint64_t> reused;
+};
@@ -0,0 +1,141 @@
+#include "ProcessRegistry.h"
+
+int ProcessRegistry::add(std::shared_ptr<Process> process)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    by_pid.push_back(Slot{process});
+    process->pid = static_cast<int>(by_pid.size());
+    by_name[process->name] = process->pid;
+    link(*process, ProcessState::READY);
+    return process->pid;
+}
+
+void ProcessRegistry::move(Process &process, ProcessState state)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (process.pid == 0 || process.listed_state == state || process.listed_state == ProcessState::FINISHED)
+        return;
+    unlink(process);
+    link(process, state);
+}
+
+void ProcessRegistry::retire(Process &process)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (process.pid == 0 || process.listed_state == ProcessState::FINISHED)
+        return;
+    unlink(process);
+    process.listed_state = ProcessState::FINISHED;
+
+    Slot &slot = by_pid[process.pid - 1];
+    slot.retired = static_cast<int>(finished.size());
+    finished.push_back(RetiredProcess{process.pid, process.name, process.get_instruction_count(),
+                                      process.getFinishTime()});
+
+    // The caller still holds the process being retired, so the reset below
+    // only ever drops an older one
+    recent.push_back(process.pid);
+    if (recent.size() > RECENT_FINISHED)
+    {
+        by_pid[recent.front() - 1].process.reset();
+        recent.pop_front();
+    }
+}
+
+std::shared_ptr<Process> ProcessRegistry::find(const std::string &name)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = by_name.find(name);
+    return it != by_name.end() ? by_pid[it->second - 1].process : nullptr;
+}
+
+std::shared_ptr<Process> ProcessRegistry::find(int pid)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (pid < 1 || static_cast<size_t>(pid) > by_pid.size())
+        return nullptr;
+    return by_pid[pid - 1].process;
+}
+
+bool ProcessRegistry::find_retired(const std::string &name, RetiredProcess &record)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = by_name.find(name);
+    if (it == by_name.end() || by_pid[it->second - 1].retired < 0)
+        return false;
+    record = finished[by_pid[it->second - 1].retired];
+    return true;
+}
+
+std::vector<std::shared_ptr<Process>> ProcessRegistry::list(ProcessState state)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    const StateList &entries = lists[static_cast<size_t>(state)];
+    std::vector<std::shared_ptr<Process>> result;
+    result.reserve(entries.count);
+    for (Process *p = entries.head; p; p = p->state_next)
+        result.push_back(by_pid[p->pid - 1].process);
+    return result;
+}
+
+std::vector<RetiredProcess> ProcessRegistry::retired()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    return finished;
+}
+
+std::vector<std::shared_ptr<Process>> ProcessRegistry::all()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    std::vector<std::shared_ptr<Process>> result;
+    result.reserve(by_pid.size());
+    for (const Slot &slot : by_pid)
+    {
+        if (slot.process)
+            result.push_back(slot.process);
+    }
+    return result;
+}
+
+size_t ProcessRegistry::count(ProcessState state)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (state == ProcessState::FINISHED)
+        return finished.size();
+    return lists[static_cast<size_t>(state)].count;
+}
+
+size_t ProcessRegistry::size()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    return by_pid.size();
+}
+
+void ProcessRegistry::link(Process &process, ProcessState state)
+{
+    StateList &entries = lists[static_cast<size_t>(state)];
+    process.listed_state = state;
+    process.state_prev = entries.tail;
+    process.state_next = nullptr;
+    if (entries.tail)
+        entries.tail->state_next = &process;
+    else
+        entries.head = &process;
+    entries.tail = &process;
+    entries.count++;
+}
+
+void ProcessRegistry::unlink(Process &process)
+{
+    StateList &entries = lists[static_cast<size_t>(process.listed_state)];
+    if (process.state_prev)
+        process.state_prev->state_next = process.state_next;
+    else
+        entries.head = process.state_next;
+    if (process.state_next)
+        process.state_next->state_prev = process.state_prev;
+    else
+        entries.tail = process.state_prev;
+    process.state_prev = process.state_next = nullptr;
+    entries.count--;
+}
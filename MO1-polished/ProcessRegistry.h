@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Process.h"
+
+// What the registry remembers about a process once it has finished
+struct RetiredProcess
+{
+    int pid;
+    std::string name;
+    size_t instructions;
+    std::chrono::system_clock::time_point finish_time;
+};
+
+// Every process the scheduler has admitted, indexed so the console never
+// scans the whole history: PIDs index a vector, names go through a hash
+// map, and each state keeps an intrusive list threaded through the
+// processes themselves. Lookups are O(1) and listings O(k) in the result.
+//
+// The lists follow the scheduler's hand-offs (move() is called when a
+// process is queued, dispatched or parked), not every store to
+// Process::state. A finished process is retired: the registry keeps a
+// RetiredProcess record and the last RECENT_FINISHED processes, and drops
+// its reference to older ones so their pool blocks can be reused. No weak
+// references are kept: with allocate_shared they would pin the block.
+class ProcessRegistry
+{
+public:
+    static constexpr size_t RECENT_FINISHED = 64;
+
+    // Assigns the next PID and lists the process as READY
+    int add(std::shared_ptr<Process> process);
+    void move(Process &process, ProcessState state);
+    void retire(Process &process);
+
+    // nullptr once the process is retired and nothing else holds it
+    std::shared_ptr<Process> find(const std::string &name);
+    std::shared_ptr<Process> find(int pid);
+    bool find_retired(const std::string &name, RetiredProcess &record);
+
+    // Unfinished processes listed under state, in the order they entered it
+    // (not arrival order: a process that leaves and comes back goes last)
+    std::vector<std::shared_ptr<Process>> list(ProcessState state);
+    // Finished processes in completion order
+    std::vector<RetiredProcess> retired();
+    std::vector<std::shared_ptr<Process>> all();
+    size_t count(ProcessState state);
+    size_t size();
+
+private:
+    static constexpr size_t STATE_COUNT = 4;
+
+    struct StateList
+    {
+        Process *head = nullptr;
+        Process *tail = nullptr;
+        size_t count = 0;
+    };
+
+    struct Slot
+    {
+        std::shared_ptr<Process> process; // dropped once it leaves recent
+        int retired = -1;                 // index into finished
+    };
+
+    void link(Process &process, ProcessState state);
+    void unlink(Process &process);
+
+    std::mutex mutex;
+    std::vector<Slot> by_pid;                    // pid - 1
+    std::unordered_map<std::string, int> by_name; // latest pid with that name
+    std::array<StateList, STATE_COUNT> lists;
+    std::vector<RetiredProcess> finished;
+    std::deque<int> recent; // retired PIDs whose processes are still held
+};
@@ -0,0 +1,95 @@
+#include "ProgramCache.h"
+
+std::mutex ProgramCache::cache_mutex;
+std::unordered_multimap<size_t, std::weak_ptr<const Program>> ProgramCache::images;
+std::atomic<size_t> ProgramCache::live{0};
+std::atomic<uint64_t> ProgramCache::hits{0};
+std::atomic<uint64_t> ProgramCache::misses{0};
+
+// FNV-1a
+static void mix(size_t &h, uint64_t value)
+{
+    h ^= static_cast<size_t>(value);
+    h *= static_cast<size_t>(1099511628211ULL);
+}
+
+static void mix(size_t &h, const std::string &text)
+{
+    mix(h, text.size());
+    for (unsigned char c : text)
+        mix(h, c);
+}
+
+size_t ProgramCache::hash(const Program &program)
+{
+    size_t h = static_cast<size_t>(14695981039346656037ULL);
+    for (const Instruction &ins : program.code)
+    {
+        mix(h, static_cast<uint64_t>(ins.op) | (static_cast<uint64_t>(ins.flags) << 8) |
+                   (static_cast<uint64_t>(ins.a) << 16) | (static_cast<uint64_t>(ins.b) << 32) |
+                   (static_cast<uint64_t>(ins.c) << 48));
+        mix(h, ins.imm);
+    }
+    for (const std::string &text : program.strings)
+        mix(h, text);
+    for (const std::string &symbol : program.symbols)
+        mix(h, symbol);
+    return h;
+}
+
+std::shared_ptr<const Program> ProgramCache::intern(Program &&program)
+{
+    size_t key = hash(program);
+
+    std::unique_lock<std::mutex> lock(cache_mutex);
+    auto range = images.equal_range(key);
+    for (auto it = range.first; it != range.second;)
+    {
+        std::shared_ptr<const Program> image = it->second.lock();
+        if (!image)
+        {
+            // Last process using it is gone
+            it = images.erase(it);
+            continue;
+        }
+        if (*image == program)
+        {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return image;
+        }
+        ++it;
+    }
+
+    // Not make_shared: the index's weak_ptr would pin the program's storage
+    std::shared_ptr<const Program> image(new Program(std::move(program)), &ProgramCache::destroy);
+    live.fetch_add(1, std::memory_order_relaxed);
+    if (images.size() >= 2 * live.load(std::memory_order_relaxed) + 16)
+        sweep();
+    images.emplace(key, image);
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return image;
+}
+
+void ProgramCache::destroy(const Program *image)
+{
+    live.fetch_sub(1, std::memory_order_relaxed);
+    delete image;
+}
+
+void ProgramCache::sweep()
+{
+    // Caller holds cache_mutex; unique programs rarely share a bucket, so
+    // most entries never get the lazy erase in intern()
+    for (auto it = images.begin(); it != images.end();)
+    {
+        if (it->second.expired())
+            it = images.erase(it);
+        else
+            ++it;
+    }
+}
+
+size_t ProgramCache::get_images()
+{
+    return live.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "Bytecode.h"
+
+// Deduplicates compiled programs. Structurally identical programs map to
+// one immutable image that every process running it shares; each process
+// keeps only its own pc, loop stack and variables. Images live as long as
+// a process references them; their dead index entries are swept once
+// they outnumber the live images.
+class ProgramCache
+{
+public:
+    static std::shared_ptr<const Program> intern(Program &&program);
+
+    static size_t get_images();
+    static uint64_t get_hits() { return hits.load(std::memory_order_relaxed); }
+    static uint64_t get_misses() { return misses.load(std::memory_order_relaxed); }
+
+private:
+    static size_t hash(const Program &program);
+    static void destroy(const Program *image);
+    static void sweep();
+
+    static std::mutex cache_mutex;
+    static std::unordered_multimap<size_t, std::weak_ptr<const Program>> images;
+    static std::atomic<size_t> live; // images some process still holds
+    static std::atomic<uint64_t> hits;
+    static std::atomic<uint64_t> misses;
+};
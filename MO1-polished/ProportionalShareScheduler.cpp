@@ -0,0 +1,165 @@
+#include "ProportionalShareScheduler.h"
+#include "Process.h"
+
+#include <algorithm>
+#include <sstream>
+
+std::vector<ProportionalShareScheduler::TicketGroup> ProportionalShareScheduler::parse_groups(const std::string &text)
+{
+    std::vector<TicketGroup> result;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        size_t eq = item.find('=');
+        if (eq == std::string::npos || eq == 0)
+            continue;
+        try
+        {
+            int tickets = std::stoi(item.substr(eq + 1));
+            if (tickets > 0)
+                result.push_back(TicketGroup{item.substr(0, eq), static_cast<uint32_t>(tickets)});
+        }
+        catch (...)
+        {
+        }
+    }
+    return result;
+}
+
+ProportionalShareScheduler::ProportionalShareScheduler(int num_cores, int min_ins, int max_ins, int quantum,
+                                                       std::vector<TicketGroup> groups, int default_tickets)
+    : Scheduler(num_cores, min_ins, max_ins),
+      quantum(std::max(quantum, 1)),
+      groups(std::move(groups)),
+      default_tickets(static_cast<uint32_t>(std::max(default_tickets, 1)))
+{
+}
+
+ProportionalShareScheduler::~ProportionalShareScheduler()
+{
+    shutdown();
+}
+
+void ProportionalShareScheduler::set_ready_queue(const std::string & /*type*/, int /*capacity*/)
+{
+    auto queue = make_queue(groups, default_tickets);
+    share_queue = queue.get();
+    ready_queue = std::move(queue);
+}
+
+void ProportionalShareScheduler::on_cpu_cycle(uint64_t cycle_number)
+{
+    Scheduler::on_cpu_cycle(cycle_number);
+    share_queue->sample();
+}
+
+void ProportionalShareScheduler::on_release(Process &process, int core_id)
+{
+    // Delay steps count against the share; a dispatch costs at least one tick
+    share_queue->charge(process, std::max<uint64_t>(ticks_held(core_id), 1));
+}
+
+ProportionalShareScheduler::ShareQueue::ShareQueue(const std::vector<TicketGroup> &configured, uint32_t default_tickets)
+    : groups(std::make_unique<GroupStats[]>(configured.size() + 1)), group_count(configured.size() + 1)
+{
+    for (size_t i = 0; i < configured.size(); ++i)
+    {
+        groups[i].prefix = configured[i].prefix;
+        groups[i].tickets = configured[i].tickets;
+    }
+    groups[configured.size()].prefix = "other";
+    groups[configured.size()].tickets = default_tickets;
+}
+
+void ProportionalShareScheduler::ShareQueue::admit(Process &process)
+{
+    // Longest matching prefix wins
+    size_t group = group_count - 1;
+    size_t matched = 0;
+    for (size_t i = 0; i + 1 < group_count; ++i)
+    {
+        const std::string &prefix = groups[i].prefix;
+        if (prefix.size() > matched && process.name.compare(0, prefix.size(), prefix) == 0)
+        {
+            group = i;
+            matched = prefix.size();
+        }
+    }
+
+    process.sched.share_group = static_cast<int>(group);
+    if (process.sched.tickets == 0)
+        process.sched.tickets = groups[group].tickets;
+}
+
+int ProportionalShareScheduler::ShareQueue::push(std::shared_ptr<Process> process, int /*core_id*/)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (process->sched.share_group < 0)
+        admit(*process);
+    groups[process->sched.share_group].held.fetch_add(process->sched.tickets, std::memory_order_relaxed);
+    insert(std::move(process));
+    total.fetch_add(1, std::memory_order_relaxed);
+    return -1;
+}
+
+std::shared_ptr<Process> ProportionalShareScheduler::ShareQueue::try_pop(int /*core_id*/)
+{
+    if (total.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    std::shared_ptr<Process> process = remove_next();
+    if (process)
+        total.fetch_sub(1, std::memory_order_relaxed);
+    return process;
+}
+
+size_t ProportionalShareScheduler::ShareQueue::size() const
+{
+    return total.load(std::memory_order_relaxed);
+}
+
+void ProportionalShareScheduler::ShareQueue::charge(Process &process, uint64_t ran)
+{
+    GroupStats &group = groups[process.sched.share_group];
+    group.held.fetch_sub(process.sched.tickets, std::memory_order_relaxed);
+    group.cpu_ticks.fetch_add(ran, std::memory_order_relaxed);
+    on_charge(process, ran);
+}
+
+void ProportionalShareScheduler::ShareQueue::sample()
+{
+    uint64_t runnable = 0;
+    for (size_t i = 0; i < group_count; ++i)
+        runnable += groups[i].held.load(std::memory_order_relaxed);
+    if (runnable == 0)
+        return;
+
+    for (size_t i = 0; i < group_count; ++i)
+    {
+        uint64_t held = groups[i].held.load(std::memory_order_relaxed);
+        groups[i].requested_ppm.fetch_add(held * 1000000 / runnable, std::memory_order_relaxed);
+    }
+    samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ProportionalShareScheduler::ShareQueue::collect_stats(std::map<int, std::map<std::string, float>> &stats) const
+{
+    auto &shared = stats[SHARED_STATS];
+    shared["queued"] = static_cast<float>(size());
+
+    uint64_t sampled = samples.load(std::memory_order_relaxed);
+    uint64_t cpu_total = 0;
+    for (size_t i = 0; i < group_count; ++i)
+        cpu_total += groups[i].cpu_ticks.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < group_count; ++i)
+    {
+        const GroupStats &group = groups[i];
+        float requested = sampled ? group.requested_ppm.load(std::memory_order_relaxed) / (sampled * 10000.0f) : 0.0f;
+        float achieved = cpu_total ? 100.0f * group.cpu_ticks.load(std::memory_order_relaxed) / cpu_total : 0.0f;
+        shared[group.prefix + "_requested_pct"] = requested;
+        shared[group.prefix + "_achieved_pct"] = achieved;
+    }
+}
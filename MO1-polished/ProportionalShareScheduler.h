@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Scheduler.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Common ground for lottery and stride scheduling. Every process holds
+// tickets: from `screen -s -tickets`, else from the longest ticket-groups
+// prefix its name matches ("p=100,web=400"), else default-tickets. Each
+// prefix is a group, plus "other" for unmatched names. get_cpu_stats()
+// reports, per group, the share of runnable tickets it held (averaged over
+// ticks) against the share of CPU ticks it actually received. The two
+// only track each other while processes outnumber cores; with idle cores
+// every group simply gets what it asks for.
+class ProportionalShareScheduler : public Scheduler
+{
+public:
+    struct TicketGroup
+    {
+        std::string prefix;
+        uint32_t tickets;
+    };
+
+    // "p=100,web=400" -> {{"p", 100}, {"web", 400}}; malformed entries are skipped
+    static std::vector<TicketGroup> parse_groups(const std::string &text);
+
+    ProportionalShareScheduler(int num_cores, int min_ins, int max_ins, int quantum,
+                               std::vector<TicketGroup> groups, int default_tickets);
+    ~ProportionalShareScheduler();
+
+
+    // The policy's queue replaces whatever ready-queue the config asked for
+    void set_ready_queue(const std::string &type, int capacity) override;
+    // Generates arrivals, then samples each group's ticket share
+    void on_cpu_cycle(uint64_t cycle_number) override;
+
+protected:
+    // Ticket bookkeeping around a policy-specific container. The base
+    // holds the lock; insert() and remove_next() run under it.
+    class ShareQueue : public ReadyQueue
+    {
+    public:
+        ShareQueue(const std::vector<TicketGroup> &groups, uint32_t default_tickets);
+
+        int push(std::shared_ptr<Process> process, int core_id) override;
+        std::shared_ptr<Process> try_pop(int core_id) override;
+        size_t size() const override;
+        void collect_stats(std::map<int, std::map<std::string, float>> &stats) const override;
+
+        // A process gave its core back after running `ran` ticks
+        void charge(Process &process, uint64_t ran);
+        // Accumulates each group's share of the tickets now runnable
+        void sample();
+
+    protected:
+        virtual void insert(std::shared_ptr<Process> process) = 0;
+        virtual std::shared_ptr<Process> remove_next() = 0;
+        virtual void on_charge(Process & /*process*/, uint64_t /*ran*/) {}
+
+    private:
+        struct GroupStats
+        {
+            std::string prefix;
+            uint32_t tickets = 0;
+            std::atomic<uint64_t> held{0};      // tickets queued or on a core
+            std::atomic<uint64_t> cpu_ticks{0};
+            std::atomic<uint64_t> requested_ppm{0}; // summed per sample, parts per million
+        };
+
+        void admit(Process &process);
+
+        mutable std::mutex mutex;
+        std::unique_ptr<GroupStats[]> groups; // configured prefixes, then "other"
+        size_t group_count;
+        std::atomic<uint64_t> samples{0};
+        std::atomic<size_t> total{0};
+    };
+
+    virtual std::unique_ptr<ShareQueue> make_queue(const std::vector<TicketGroup> &groups, uint32_t default_tickets) = 0;
+
+    int time_slice(const std::shared_ptr<Process> & /*process*/) const override { return quantum; }
+    void on_release(Process &process, int core_id) override;
+
+    int quantum;
+    std::vector<TicketGroup> groups;
+    uint32_t default_tickets;
+    ShareQueue *share_queue = nullptr; // owned by ready_queue
+};
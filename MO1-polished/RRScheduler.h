@@ -11,25 +11,13 @@ public:
     RRScheduler(int num_cores, int quantum_ms, int min_ins, int max_ins, int delay_per_exec);
     ~RRScheduler();
 
-    void run_core(int core_id) override;
-    void start_core_threads() override;
-
-    void start() override;
-    void stop_scheduler();
-    bool is_scheduler_running() const;
-    void start_process_generator() override;
+    std::string name() const override { return "RR Scheduler"; }
     void set_batch_frequency(int freq) { batch_process_freq = freq; }
-    void on_cpu_cycle(uint64_t cycle_number) override;
-    void generate_new_process();
-
-    std::vector<std::shared_ptr<Process>> get_running_processes() override;
 
 protected:
+    int time_slice(const std::shared_ptr<Process> & /*process*/) const override { return time_quantum; }
+
     int time_quantum;
     int min_ins;
     int max_ins;
-
-    std::mutex running_mutex;
-    std::map<int, std::shared_ptr<Process>> current_processes;
-    std::atomic<int> next_pid{1};
 };
@@ -0,0 +1,260 @@
+#include "ReadyQueue.h"
+#include "Process.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+std::unique_ptr<ReadyQueue> ReadyQueue::create(const std::string &type, int num_cores, size_t capacity)
+{
+    if (type == "lockfree")
+        return std::make_unique<LockFreeReadyQueue>(capacity);
+    if (type == "work-stealing")
+        return std::make_unique<WorkStealingReadyQueue>(num_cores);
+
+    if (type != "mutex")
+        std::cerr << "[WARN] Unknown ready-queue \"" << type << "\", using mutex.\n";
+    return std::make_unique<LockedReadyQueue>();
+}
+
+// --- LockedReadyQueue ---
+
+int LockedReadyQueue::push(std::shared_ptr<Process> process, int /*core_id*/)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    queue.push(std::move(process));
+    return -1;
+}
+
+std::shared_ptr<Process> LockedReadyQueue::try_pop(int /*core_id*/)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (queue.empty())
+        return nullptr;
+
+    auto process = std::move(queue.front());
+    queue.pop();
+    return process;
+}
+
+size_t LockedReadyQueue::size() const
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    return queue.size();
+}
+
+// --- LockFreeReadyQueue ---
+
+LockFreeReadyQueue::LockFreeReadyQueue(size_t capacity)
+{
+    // Ring indexing needs a power of two
+    size_t rounded = 2;
+    while (rounded < capacity)
+        rounded <<= 1;
+
+    cells = std::make_unique<Cell[]>(rounded);
+    mask = rounded - 1;
+    for (size_t i = 0; i < rounded; ++i)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+int LockFreeReadyQueue::push(std::shared_ptr<Process> process, int /*core_id*/)
+{
+    // Keep FIFO order: once something has spilled, later arrivals queue behind it
+    if (overflow_count.load(std::memory_order_acquire) == 0 && try_push_ring(process))
+        return -1;
+
+    std::unique_lock<std::mutex> lock(overflow_mutex);
+    overflow.push_back(std::move(process));
+    overflow_count.fetch_add(1, std::memory_order_release);
+    return -1;
+}
+
+std::shared_ptr<Process> LockFreeReadyQueue::try_pop(int /*core_id*/)
+{
+    if (auto process = try_pop_ring())
+        return process;
+
+    if (overflow_count.load(std::memory_order_acquire) == 0)
+        return nullptr;
+
+    std::unique_lock<std::mutex> lock(overflow_mutex);
+    if (overflow.empty())
+        return nullptr;
+
+    auto process = std::move(overflow.front());
+    overflow.pop_front();
+    overflow_count.fetch_sub(1, std::memory_order_release);
+    return process;
+}
+
+size_t LockFreeReadyQueue::size() const
+{
+    // Snapshot only; exact under quiescence, which is all is_done() needs
+    size_t head = dequeue_pos.load(std::memory_order_acquire);
+    size_t tail = enqueue_pos.load(std::memory_order_acquire);
+    size_t in_ring = tail > head ? tail - head : 0;
+    return in_ring + overflow_count.load(std::memory_order_acquire);
+}
+
+bool LockFreeReadyQueue::try_push_ring(std::shared_ptr<Process> &process)
+{
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    Cell *cell;
+
+    for (;;)
+    {
+        cell = &cells[pos & mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if (diff == 0)
+        {
+            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            return false; // full
+        }
+        else
+        {
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->process = std::move(process);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+std::shared_ptr<Process> LockFreeReadyQueue::try_pop_ring()
+{
+    size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    Cell *cell;
+
+    for (;;)
+    {
+        cell = &cells[pos & mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+        if (diff == 0)
+        {
+            if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            return nullptr; // empty
+        }
+        else
+        {
+            pos = dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    auto process = std::move(cell->process);
+    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+    return process;
+}
+
+// --- WorkStealingReadyQueue ---
+
+WorkStealingReadyQueue::WorkStealingReadyQueue(int num_cores)
+{
+    for (int i = 0; i < std::max(num_cores, 1); ++i)
+        deques.push_back(std::make_unique<CoreDeque>());
+}
+
+int WorkStealingReadyQueue::push(std::shared_ptr<Process> process, int core_id)
+{
+    int n = static_cast<int>(deques.size());
+    int target = (core_id >= 0 && core_id < n)
+                     ? core_id
+                     : static_cast<int>(next_core.fetch_add(1, std::memory_order_relaxed) % n);
+
+    CoreDeque &dq = *deques[target];
+    {
+        std::unique_lock<std::mutex> lock(dq.mutex);
+        dq.processes.push_back(std::move(process));
+        dq.depth.store(dq.processes.size(), std::memory_order_release);
+    }
+    total.fetch_add(1, std::memory_order_acq_rel);
+    return target;
+}
+
+std::shared_ptr<Process> WorkStealingReadyQueue::try_pop(int core_id)
+{
+    if (core_id >= 0 && core_id < static_cast<int>(deques.size()))
+    {
+        CoreDeque &dq = *deques[core_id];
+        if (dq.depth.load(std::memory_order_acquire) > 0)
+        {
+            std::unique_lock<std::mutex> lock(dq.mutex);
+            if (!dq.processes.empty())
+            {
+                auto process = std::move(dq.processes.front());
+                dq.processes.pop_front();
+                dq.depth.store(dq.processes.size(), std::memory_order_release);
+                total.fetch_sub(1, std::memory_order_acq_rel);
+                return process;
+            }
+        }
+    }
+
+    if (total.load(std::memory_order_acquire) == 0)
+        return nullptr;
+    return steal(core_id);
+}
+
+std::shared_ptr<Process> WorkStealingReadyQueue::steal(int thief)
+{
+    // Pick the deepest victim from the depth hints, then confirm under its lock
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        int victim = -1;
+        size_t deepest = 0;
+        for (int i = 0; i < static_cast<int>(deques.size()); ++i)
+        {
+            size_t depth = deques[i]->depth.load(std::memory_order_relaxed);
+            if (i != thief && depth > deepest)
+            {
+                deepest = depth;
+                victim = i;
+            }
+        }
+        if (victim < 0)
+            return nullptr;
+
+        CoreDeque &dq = *deques[victim];
+        std::unique_lock<std::mutex> lock(dq.mutex);
+        if (dq.processes.empty())
+            continue;
+
+        auto process = std::move(dq.processes.back());
+        dq.processes.pop_back();
+        dq.depth.store(dq.processes.size(), std::memory_order_release);
+        total.fetch_sub(1, std::memory_order_acq_rel);
+        dq.stolen_from.fetch_add(1, std::memory_order_relaxed);
+        if (thief >= 0 && thief < static_cast<int>(deques.size()))
+            deques[thief]->steals.fetch_add(1, std::memory_order_relaxed);
+        return process;
+    }
+    return nullptr;
+}
+
+size_t WorkStealingReadyQueue::size() const
+{
+    return total.load(std::memory_order_acquire);
+}
+
+void WorkStealingReadyQueue::collect_stats(std::map<int, std::map<std::string, float>> &stats) const
+{
+    for (int i = 0; i < static_cast<int>(deques.size()); ++i)
+    {
+        stats[i]["queue_depth"] = static_cast<float>(deques[i]->depth.load(std::memory_order_relaxed));
+        stats[i]["steals"] = static_cast<float>(deques[i]->steals.load(std::memory_order_relaxed));
+        stats[i]["stolen_from"] = static_cast<float>(deques[i]->stolen_from.load(std::memory_order_relaxed));
+    }
+}
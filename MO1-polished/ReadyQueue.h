@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+class Process;
+
+// Storage for processes waiting for a core. The scheduler only talks to this
+// interface, so the backing structure can be picked from config.txt.
+class ReadyQueue
+{
+public:
+    virtual ~ReadyQueue() = default;
+
+    // core_id is the core handing the process back (-1 for new arrivals).
+    // Returns the core the process was queued for, or -1 if any core may take it
+    virtual int push(std::shared_ptr<Process> process, int core_id) = 0;
+    // Non-blocking; returns nullptr when nothing is ready
+    virtual std::shared_ptr<Process> try_pop(int core_id) = 0;
+    virtual size_t size() const = 0;
+
+    // get_cpu_stats() key for entries that belong to the queue as a whole
+    static constexpr int SHARED_STATS = -1;
+
+    // Adds queue-specific per-core entries to Scheduler::get_cpu_stats()
+    virtual void collect_stats(std::map<int, std::map<std::string, float>> & /*stats*/) const {}
+
+    bool empty() const { return size() == 0; }
+
+    // Builds the queue named by the "ready-queue" config key
+    static std::unique_ptr<ReadyQueue> create(const std::string &type, int num_cores, size_t capacity);
+};
+
+// Original behaviour: one FIFO behind one mutex
+class LockedReadyQueue : public ReadyQueue
+{
+public:
+    int push(std::shared_ptr<Process> process, int core_id) override;
+    std::shared_ptr<Process> try_pop(int core_id) override;
+    size_t size() const override;
+
+private:
+    mutable std::mutex mutex;
+    std::queue<std::shared_ptr<Process>> queue;
+};
+
+// Bounded multi-producer/multi-consumer ring (sequence-numbered cells).
+// Pushes beyond capacity spill into a locked overflow list so add_process never
+// drops or blocks; the lock is only touched while the ring is saturated.
+class LockFreeReadyQueue : public ReadyQueue
+{
+public:
+    explicit LockFreeReadyQueue(size_t capacity);
+
+    int push(std::shared_ptr<Process> process, int core_id) override;
+    std::shared_ptr<Process> try_pop(int core_id) override;
+    size_t size() const override;
+
+private:
+    struct alignas(64) Cell
+    {
+        std::atomic<size_t> sequence;
+        std::shared_ptr<Process> process;
+    };
+
+    bool try_push_ring(std::shared_ptr<Process> &process);
+    std::shared_ptr<Process> try_pop_ring();
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> enqueue_pos{0};
+    alignas(64) std::atomic<size_t> dequeue_pos{0};
+
+    std::mutex overflow_mutex;
+    std::deque<std::shared_ptr<Process>> overflow;
+    std::atomic<size_t> overflow_count{0};
+};
+
+// One deque per core. New arrivals are dealt round-robin, preempted processes
+// return to the deque of the core that ran them, and a core with an empty
+// deque steals from the tail of the deepest one.
+class WorkStealingReadyQueue : public ReadyQueue
+{
+public:
+    explicit WorkStealingReadyQueue(int num_cores);
+
+    int push(std::shared_ptr<Process> process, int core_id) override;
+    std::shared_ptr<Process> try_pop(int core_id) override;
+    size_t size() const override;
+    void collect_stats(std::map<int, std::map<std::string, float>> &stats) const override;
+
+private:
+    struct alignas(64) CoreDeque
+    {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<Process>> processes;
+        std::atomic<size_t> depth{0};
+        std::atomic<uint64_t> steals{0};      // taken from other cores
+        std::atomic<uint64_t> stolen_from{0}; // taken by other cores
+    };
+
+    std::shared_ptr<Process> steal(int thief);
+
+    std::vector<std::unique_ptr<CoreDeque>> deques;
+    std::atomic<unsigned> next_core{0};
+    std::atomic<size_t> total{0};
+};
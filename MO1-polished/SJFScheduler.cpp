@@ -0,0 +1,131 @@
+#include "SJFScheduler.h"
+#include "Process.h"
+
+SJFScheduler::SJFScheduler(int num_cores, int min_ins, int max_ins, bool preemptive)
+    : Scheduler(num_cores, min_ins, max_ins), preemptive(preemptive), on_core(num_cores, nullptr)
+{
+    set_ready_queue("", 0);
+}
+
+SJFScheduler::~SJFScheduler()
+{
+    shutdown();
+}
+
+void SJFScheduler::set_ready_queue(const std::string & /*type*/, int /*capacity*/)
+{
+    auto queue = std::make_unique<RemainingWorkQueue>();
+    work_queue = queue.get();
+    ready_queue = std::move(queue);
+}
+
+void SJFScheduler::on_cpu_cycle(uint64_t cycle_number)
+{
+    Scheduler::on_cpu_cycle(cycle_number);
+
+    if (preemptive)
+        check_preemption();
+}
+
+uint64_t SJFScheduler::remaining_work(const Process &process)
+{
+    uint64_t total = process.get_instruction_count();
+    uint64_t done = static_cast<uint64_t>(process.getCurrentCommandIndex());
+    return total > done ? total - done : 0;
+}
+
+void SJFScheduler::on_dispatch(Process &process, int core_id)
+{
+    std::unique_lock<std::mutex> lock(cores_mutex);
+    on_core[core_id] = &process;
+}
+
+void SJFScheduler::on_release(Process & /*process*/, int core_id)
+{
+    std::unique_lock<std::mutex> lock(cores_mutex);
+    on_core[core_id] = nullptr;
+}
+
+void SJFScheduler::check_preemption()
+{
+    uint64_t shortest;
+    if (!work_queue->peek_shortest(shortest))
+        return;
+
+    // An idle core will take the job anyway; otherwise evict the longest
+    int victim = -1;
+    uint64_t longest = shortest;
+    std::unique_lock<std::mutex> lock(cores_mutex);
+    for (int core_id = 0; core_id < num_cores; ++core_id)
+    {
+        Process *process = on_core[core_id];
+        if (!process)
+            return;
+        if (preemption_requested(core_id))
+            continue;
+
+        uint64_t remaining = remaining_work(*process);
+        if (remaining > longest)
+        {
+            longest = remaining;
+            victim = core_id;
+        }
+    }
+
+    if (victim >= 0)
+    {
+        request_preemption(victim);
+        work_queue->preemptions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+int SJFScheduler::RemainingWorkQueue::push(std::shared_ptr<Process> process, int /*core_id*/)
+{
+    // Constant while queued, so the key stays valid until popped
+    uint64_t remaining = remaining_work(*process);
+    std::unique_lock<std::mutex> lock(mutex);
+    heap.push(Entry{remaining, next_sequence++, std::move(process)});
+    total.fetch_add(1, std::memory_order_relaxed);
+    return -1;
+}
+
+std::shared_ptr<Process> SJFScheduler::RemainingWorkQueue::try_pop(int /*core_id*/)
+{
+    if (total.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (heap.empty())
+        return nullptr;
+    std::shared_ptr<Process> process = heap.top().process;
+    heap.pop();
+    total.fetch_sub(1, std::memory_order_relaxed);
+    return process;
+}
+
+size_t SJFScheduler::RemainingWorkQueue::size() const
+{
+    return total.load(std::memory_order_relaxed);
+}
+
+bool SJFScheduler::RemainingWorkQueue::peek_shortest(uint64_t &remaining) const
+{
+    if (total.load(std::memory_order_relaxed) == 0)
+        return false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (heap.empty())
+        return false;
+    remaining = heap.top().remaining;
+    return true;
+}
+
+void SJFScheduler::RemainingWorkQueue::collect_stats(std::map<int, std::map<std::string, float>> &stats) const
+{
+    auto &shared = stats[SHARED_STATS];
+    uint64_t shortest = 0;
+    bool any = peek_shortest(shortest);
+    shared["queued"] = static_cast<float>(size());
+    shared["shortest_remaining"] = any ? static_cast<float>(shortest) : 0.0f;
+    shared["preemptions"] = static_cast<float>(preemptions.load(std::memory_order_relaxed));
+}
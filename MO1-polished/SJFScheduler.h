@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Scheduler.h"
+#include <mutex>
+#include <queue>
+#include <vector>
+
+// Shortest job first, using the exact remaining instruction count every
+// process carries. Ready processes sit in a min-heap keyed on remaining
+// work. Non-preemptive (sjf) runs each dispatch to completion or SLEEP;
+// preemptive (srtf) also checks after every tick's arrivals and wake-ups,
+// and asks the core with the most remaining work to yield when a shorter
+// job is waiting and no core is idle.
+class SJFScheduler : public Scheduler
+{
+public:
+    SJFScheduler(int num_cores, int min_ins, int max_ins, bool preemptive);
+    ~SJFScheduler();
+
+    std::string name() const override { return preemptive ? "SRTF Scheduler" : "SJF Scheduler"; }
+
+    // The heap replaces whatever ready-queue the config asked for
+    void set_ready_queue(const std::string &type, int capacity) override;
+    // Generates arrivals, then (srtf) preempts for anything shorter
+    void on_cpu_cycle(uint64_t cycle_number) override;
+
+    static uint64_t remaining_work(const Process &process);
+
+protected:
+    void on_dispatch(Process &process, int core_id) override;
+    void on_release(Process &process, int core_id) override;
+
+private:
+    class RemainingWorkQueue : public ReadyQueue
+    {
+    public:
+        int push(std::shared_ptr<Process> process, int core_id) override;
+        std::shared_ptr<Process> try_pop(int core_id) override;
+        size_t size() const override;
+        void collect_stats(std::map<int, std::map<std::string, float>> &stats) const override;
+
+        // Remaining work of the shortest queued job; false when empty
+        bool peek_shortest(uint64_t &remaining) const;
+
+        std::atomic<uint64_t> preemptions{0};
+
+    private:
+        struct Entry
+        {
+            uint64_t remaining;
+            uint64_t sequence; // FIFO among equal keys
+            std::shared_ptr<Process> process;
+
+            bool operator>(const Entry &other) const
+            {
+                return remaining != other.remaining ? remaining > other.remaining : sequence > other.sequence;
+            }
+        };
+
+        mutable std::mutex mutex;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+        uint64_t next_sequence = 0;
+        std::atomic<size_t> total{0};
+    };
+
+    void check_preemption();
+
+    bool preemptive;
+    RemainingWorkQueue *work_queue; // owned by ready_queue
+
+    std::mutex cores_mutex;
+    std::vector<Process *> on_core; // core_id -> process it holds, or nullptr
+};
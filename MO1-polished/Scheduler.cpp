@@ -1,18 +1,159 @@
 // Scheduler.cpp
 #include "Scheduler.h"
+#include "ProcessFactory.h"
+#include "ConsoleManager.h"
+#include "ScreenConsole.h"
+#include "Command.h"
+#include "ConfigManager.h"
+#include "FCFSScheduler.h"
+#include "RRScheduler.h"
+#include "MLFQScheduler.h"
+#include "SJFScheduler.h"
+#include "CFSScheduler.h"
+#include "EDFScheduler.h"
+#include "LotteryScheduler.h"
+#include "StrideScheduler.h"
 #include <chrono>
 #include <algorithm>
 #include <iostream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+// Idle cores retry this many times before parking; under load the ready
+// queue usually refills well within this window
+static constexpr int SPIN_BEFORE_PARK = 64;
 
 Scheduler::Scheduler(int num_cores, int min_ins, int max_ins)
-    : min_instructions(min_ins), max_instructions(max_ins)
+    : num_cores(num_cores), min_instructions(min_ins), max_instructions(max_ins)
 {
+    core_stats = std::make_unique<CoreStats[]>(num_cores);
+    preempt_requested = std::make_unique<std::atomic<bool>[]>(num_cores);
     for (int i = 0; i < num_cores; ++i)
+        preempt_requested[i] = false;
+
+    core_words = (static_cast<size_t>(num_cores) + 63) / 64;
+    busy_cores = std::make_unique<std::atomic<uint64_t>[]>(core_words);
+    stepped_cores = std::make_unique<std::atomic<uint64_t>[]>(core_words);
+    for (size_t w = 0; w < core_words; ++w)
     {
-        core_available.push_back(true);
-        core_process_count[i] = 0;
-        core_util_time[i] = 0;
+        busy_cores[w] = 0;
+        stepped_cores[w] = 0;
     }
+
+    ready_queue = ReadyQueue::create("mutex", num_cores, 0);
+    parking_lot = std::make_unique<ParkingLot>(num_cores);
+    core_states.resize(num_cores);
+    set_generation(0, 1, 64);
+}
+
+void Scheduler::set_generation(uint64_t workload_seed, int threads, int buffer)
+{
+    // 0 asks for a fresh seed; vmstat shows it so the run can be replayed
+    seed = workload_seed != 0 ? workload_seed : (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    generator = std::make_unique<ProcessGenerator>(
+        [this](uint64_t index)
+        { return build_batch_process(index); },
+        threads, static_cast<size_t>(std::max(buffer, 1)));
+}
+
+std::shared_ptr<Process> Scheduler::build_batch_process(uint64_t index)
+{
+    std::ostringstream oss;
+    oss << "p" << std::setw(2) << std::setfill('0') << index + 1;
+
+    auto process = ProcessFactory::generate_dummy_process(oss.str(), min_instructions, max_instructions,
+                                                          ProcessFactory::stream_seed(seed, index));
+    process->add_command(process->arena.create<PrintCommand>("Process " + std::string(PROCESS_NAME_TOKEN) + " has completed all its commands."));
+
+    // Its own stream, so turning deadlines on leaves the programs unchanged
+    WorkloadRng realtime(ProcessFactory::stream_seed(seed ^ 0x5245414C54494D45ULL, index));
+    if (realtime_percent > 0 && static_cast<int>(realtime() % 100) < realtime_percent)
+        process->sched.relative_deadline = static_cast<uint64_t>(realtime_deadline);
+    return process;
+}
+
+void Scheduler::set_realtime(int percent, int deadline_ticks)
+{
+    realtime_percent = std::min(std::max(percent, 0), 100);
+    realtime_deadline = std::max(deadline_ticks, 1);
+}
+
+std::shared_ptr<Process> Scheduler::create_named_process(const std::string &name, int nice, int deadline_ticks, int tickets)
+{
+    // FNV-1a rather than std::hash so the stream is the same on every
+    // platform; the top bit keeps it apart from the batch indices
+    uint64_t name_hash = 14695981039346656037ULL;
+    for (unsigned char c : name)
+        name_hash = (name_hash ^ c) * 1099511628211ULL;
+    name_hash |= 1ULL << 63;
+    auto process = ProcessFactory::generate_dummy_process(name, min_instructions, max_instructions,
+                                                          ProcessFactory::stream_seed(seed, name_hash));
+    process->add_command(process->arena.create<PrintCommand>("Process " + std::string(PROCESS_NAME_TOKEN) + " has completed all its commands."));
+    process->sched.nice = nice;
+    process->sched.relative_deadline = static_cast<uint64_t>(std::max(deadline_ticks, 0));
+    process->sched.tickets = static_cast<uint32_t>(std::max(tickets, 0));
+    return process;
+}
+
+void Scheduler::on_cpu_cycle(uint64_t cycle_number)
+{
+    if (!generating_processes.load())
+        return;
+
+    if (batch_process_freq > 0 && cycle_number % batch_process_freq == 0)
+        generate_new_process();
+}
+
+void Scheduler::generate_new_process()
+{
+    generator->start();
+    std::shared_ptr<Process> process = generator->take();
+    if (!process)
+        return;
+
+    std::string name = process->getName();
+    add_process(process);
+
+    ConsoleManager *cm = ConsoleManager::getInstance();
+    if (!cm->hasConsole(name))
+        cm->createConsole("screen", name);
+
+    auto screen = std::dynamic_pointer_cast<ScreenConsole>(cm->getConsoleByName(name));
+    if (screen)
+        screen->attachProcess(process);
+}
+
+std::unique_ptr<Scheduler> Scheduler::create(const std::string &type, const ConfigManager &cfg)
+{
+    int num_cpu = cfg.getInt("num-cpu", 2);
+    int min_ins = cfg.getInt("min-ins", 1000);
+    int max_ins = cfg.getInt("max-ins", 2000);
+
+    if (type == "rr")
+        return std::make_unique<RRScheduler>(num_cpu, cfg.getInt("quantum-cycles", 5), min_ins, max_ins,
+                                             cfg.getInt("delay-per-exec", 100));
+    if (type == "mlfq")
+        return std::make_unique<MLFQScheduler>(
+            num_cpu, min_ins, max_ins,
+            MLFQScheduler::parse_quanta(cfg.getString("mlfq-quanta", "2,4,8"), cfg.getInt("mlfq-levels", 3)),
+            cfg.getInt("mlfq-boost-interval", 1000));
+    if (type == "sjf" || type == "srtf")
+        return std::make_unique<SJFScheduler>(num_cpu, min_ins, max_ins, type == "srtf");
+    if (type == "cfs")
+        return std::make_unique<CFSScheduler>(num_cpu, min_ins, max_ins, cfg.getInt("cfs-target-latency", 20),
+                                              cfg.getInt("cfs-min-granularity", 2));
+    if (type == "edf")
+        return std::make_unique<EDFScheduler>(num_cpu, min_ins, max_ins, cfg.getInt("quantum-cycles", 5));
+    if (type == "lottery")
+        return std::make_unique<LotteryScheduler>(
+            num_cpu, min_ins, max_ins, cfg.getInt("quantum-cycles", 5),
+            ProportionalShareScheduler::parse_groups(cfg.getString("ticket-groups", "")), cfg.getInt("default-tickets", 100));
+    if (type == "stride")
+        return std::make_unique<StrideScheduler>(
+            num_cpu, min_ins, max_ins, cfg.getInt("quantum-cycles", 5),
+            ProportionalShareScheduler::parse_groups(cfg.getString("ticket-groups", "")), cfg.getInt("default-tickets", 100));
+    return std::make_unique<FCFSScheduler>(num_cpu, min_ins, max_ins);
 }
 
 Scheduler::~Scheduler()
@@ -20,17 +161,159 @@ Scheduler::~Scheduler()
     shutdown();
 }
 
+void Scheduler::set_ready_queue(const std::string &type, int capacity)
+{
+    ready_queue = ReadyQueue::create(type, num_cores, static_cast<size_t>(std::max(capacity, 2)));
+}
+
 void Scheduler::add_process(std::shared_ptr<Process> process)
 {
-    std::unique_lock<std::mutex> lock(queue_mutex);
-    ready_queue.push(process);
-    all_processes.push_back(process);
-    queue_condition.notify_one();
+    process->set_delay_per_exec(delay_per_exec);
+    process->set_log_capacity(static_cast<size_t>(std::max(log_capacity, 1)));
+    if (process->sched.relative_deadline > 0)
+        process->sched.deadline = get_current_tick() + process->sched.relative_deadline;
+    registry.add(process);
+    vm_stats.processes_created.fetch_add(1, std::memory_order_relaxed);
+    enqueue_ready(process, -1);
+}
+
+void Scheduler::enqueue_ready(std::shared_ptr<Process> process, int core_id)
+{
+    process->state = ProcessState::READY;
+    registry.move(*process, ProcessState::READY);
+    int target = ready_queue->push(std::move(process), core_id);
+    parking_lot->unpark_one(target);
+}
+
+void Scheduler::sleep_process(std::shared_ptr<Process> process)
+{
+    uint64_t wake_tick = process->wake_tick;
+    registry.move(*process, ProcessState::WAITING);
+    std::unique_lock<std::mutex> lock(sleepers_mutex);
+    sleepers.schedule(std::move(process), wake_tick);
+    vm_stats.sleeping.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Scheduler::finish_process(Process &process)
+{
+    registry.retire(process);
+    vm_stats.processes_finished.fetch_add(1, std::memory_order_relaxed);
+    if (process.sched.deadline > 0)
+        vm_stats.record_deadline(get_current_tick(), process.sched.deadline);
+    on_finished(process);
+}
+
+void Scheduler::wake_sleepers(uint64_t now)
+{
+    std::vector<std::shared_ptr<Process>> woken;
+    {
+        std::unique_lock<std::mutex> lock(sleepers_mutex);
+        sleepers.advance(now, woken);
+        waking.fetch_add(woken.size());
+    }
+    vm_stats.sleeping.fetch_sub(woken.size(), std::memory_order_relaxed);
+    for (auto &process : woken)
+    {
+        on_wake(*process);
+        enqueue_ready(std::move(process), -1);
+        waking.fetch_sub(1);
+    }
+}
+
+uint64_t Scheduler::next_wakeup()
+{
+    std::unique_lock<std::mutex> lock(sleepers_mutex);
+    return sleepers.next_expiry();
+}
+
+void Scheduler::record_ticks(uint64_t elapsed, bool busy)
+{
+    for (size_t w = 0; w < core_words; ++w)
+    {
+        uint64_t bits = busy_cores[w].load(std::memory_order_relaxed) |
+                        stepped_cores[w].exchange(0, std::memory_order_relaxed);
+        int first = static_cast<int>(w * 64);
+        int last = std::min(first + 64, num_cores);
+        for (int core_id = first; core_id < last; ++core_id)
+        {
+            CoreStats &core = core_stats[core_id];
+            core.total_ticks.fetch_add(elapsed, std::memory_order_relaxed);
+            // Only the last of a skipped span can be busy
+            if ((bits >> (core_id - first)) & 1)
+                core.busy_ticks.fetch_add(1, std::memory_order_relaxed);
+        }
+        busy = busy || bits != 0;
+    }
+
+    vm_stats.record_ticks(elapsed, busy, ready_queue->size());
+}
+
+void Scheduler::dispatch(const std::shared_ptr<Process> &process, int core_id)
+{
+    process->state = ProcessState::RUNNING;
+    process->current_core = core_id;
+    preempt_requested[core_id].store(false, std::memory_order_relaxed);
+    core_states[core_id].ticks_held = 0;
+    registry.move(*process, ProcessState::RUNNING);
+    mark_core_busy(core_id);
+    on_dispatch(*process, core_id);
+}
+
+void Scheduler::release(Process &process, int core_id)
+{
+    on_release(process, core_id);
+    mark_core_idle(core_id);
+    process.current_core = -1;
+}
+
+void Scheduler::mark_core_busy(int core_id)
+{
+    uint64_t bit = 1ULL << (core_id % 64);
+    busy_cores[core_id / 64].fetch_or(bit, std::memory_order_relaxed);
+    busy_core_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Scheduler::mark_core_idle(int core_id)
+{
+    uint64_t bit = 1ULL << (core_id % 64);
+    // Still counts as busy for the tick it was released in
+    stepped_cores[core_id / 64].fetch_or(bit, std::memory_order_relaxed);
+    busy_cores[core_id / 64].fetch_and(~bit, std::memory_order_relaxed);
+    busy_core_count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void Scheduler::on_tick(uint64_t cycle_number)
+{
+    {
+        std::unique_lock<std::mutex> lock(tick_mutex);
+        current_tick.store(cycle_number, std::memory_order_relaxed);
+    }
+    tick_cv.notify_all();
+    wake_sleepers(cycle_number);
+    on_cpu_cycle(cycle_number);
+}
+
+std::shared_ptr<Process> Scheduler::next_process(int core_id)
+{
+    for (int spin = 0; spin < SPIN_BEFORE_PARK && running; ++spin)
+    {
+        // Claim the core before popping so is_done() never sees the process
+        // in neither the queue nor a core
+        core_stats[core_id].available = false;
+        if (auto process = ready_queue->try_pop(core_id))
+            return process;
+        core_stats[core_id].available = true;
+        std::this_thread::yield();
+    }
+
+    parking_lot->park(core_id, [this]
+                      { return !running || !ready_queue->empty(); });
+    return nullptr;
 }
 
 void Scheduler::start_core_threads() // IMPORTANT: check where should u run
 {
-    for (int i = 0; i < static_cast<int>(core_available.size()); ++i)
+    for (int i = 0; i < num_cores; ++i)
     {
         cpu_cores.emplace_back(&Scheduler::run_core, this, i);
     }
@@ -42,7 +325,11 @@ void Scheduler::shutdown()
     running = false;
     stop_scheduler();
 
-    queue_condition.notify_all();
+    parking_lot->unpark_all();
+    {
+        std::unique_lock<std::mutex> lock(tick_mutex);
+    }
+    tick_cv.notify_all();
 
     for (auto &t : cpu_cores)
     {
@@ -55,126 +342,223 @@ void Scheduler::run_core(int core_id)
 {
     while (running)
     {
-        std::shared_ptr<Process> process;
+        std::shared_ptr<Process> process = next_process(core_id);
+        if (!process)
+            continue;
 
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            queue_condition.wait(lock, [this]
-                                 { return !running || !ready_queue.empty(); });
+        dispatch(process, core_id);
 
+        int slice = time_slice(process);
+        int executed = 0;
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        while ((slice <= 0 || executed < slice) && !process->isFinished() && !process->isWaiting() &&
+               !preemption_requested(core_id))
+        {
             if (!running)
                 break;
 
-            if (!ready_queue.empty())
+            core_states[core_id].ticks_held++;
+            if (process->can_execute())
             {
-                process = ready_queue.front();
-                ready_queue.pop();
-                core_available[core_id] = false;
+                process->execute(core_id);
+                executed++;
             }
             else
             {
-                continue;
+                // One delay step per tick, as under step_core, instead of
+                // burning through them at loop speed
+                uint64_t seen = get_current_tick();
+                std::unique_lock<std::mutex> lock(tick_mutex);
+                tick_cv.wait(lock, [&]
+                             { return !running || current_tick.load(std::memory_order_relaxed) != seen ||
+                                      preemption_requested(core_id); });
             }
         }
 
-        if (process)
-        {
-            {
-                std::unique_lock<std::mutex> lock(running_mutex);
-                current_processes[core_id] = process;
-            }
-            auto start_time = std::chrono::high_resolution_clock::now();
-            process->execute(core_id);
-            auto end_time = std::chrono::high_resolution_clock::now();
+        auto end = std::chrono::high_resolution_clock::now();
+        uint64_t duration_us = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
 
-            int duration_ms = static_cast<int>(
-                std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count());
+        core_stats[core_id].busy_time_us.fetch_add(duration_us, std::memory_order_relaxed);
+        core_stats[core_id].dispatches.fetch_add(1, std::memory_order_relaxed);
 
-            core_util_time[core_id] += duration_ms;
-            core_process_count[core_id]++;
-            total_cpu_time = std::max(total_cpu_time, core_util_time[core_id]);
+        release(*process, core_id);
 
-            core_available[core_id] = true;
-            if (process->is_finished)
-            {
-                current_processes.erase(core_id);
-            }
+        // Sleeping or preempted: hand it off before the core is released
+        if (process->isWaiting())
+            sleep_process(process);
+        else if (process->isFinished())
+            finish_process(*process);
+        else if (running)
+        {
+            if (slice > 0 && executed >= slice)
+                on_slice_expired(*process);
+            enqueue_ready(process, core_id);
         }
+
+        core_stats[core_id].available = true;
     }
 }
-void Scheduler::start()
-{
-    start_core_threads();
-    start_process_generator();
-}
 
-std::vector<std::shared_ptr<Process>> Scheduler::get_running_processes()
+bool Scheduler::step_core(int core_id)
 {
-    std::unique_lock<std::mutex> lock(running_mutex);
-    std::vector<std::shared_ptr<Process>> running_procs;
-    for (const auto &pair : current_processes)
+    CoreState &core = core_states[core_id];
+
+    if (!core.process)
     {
-        if (!pair.second->is_finished)
+        core_stats[core_id].available = false;
+        core.process = ready_queue->try_pop(core_id);
+        if (!core.process)
         {
-            running_procs.push_back(pair.second);
+            core_stats[core_id].available = true;
+            return false;
         }
+
+        core.slice_used = 0;
+        dispatch(core.process, core_id);
+    }
+
+    std::shared_ptr<Process> process = core.process;
+    core.ticks_held++;
+    int before = process->getCurrentCommandIndex();
+    process->execute(core_id);
+    if (process->getCurrentCommandIndex() != before || process->isFinished())
+        core.slice_used++;
+
+    int slice = time_slice(process);
+    if (!process->isFinished() && !process->isWaiting() && (slice <= 0 || core.slice_used < slice) &&
+        !preemption_requested(core_id))
+        return true;
+
+    core_stats[core_id].dispatches.fetch_add(1, std::memory_order_relaxed);
+    release(*process, core_id);
+
+    core.process.reset();
+    if (process->isWaiting())
+        sleep_process(process);
+    else if (process->isFinished())
+        finish_process(*process);
+    else
+    {
+        if (slice > 0 && core.slice_used >= slice)
+            on_slice_expired(*process);
+        enqueue_ready(process, core_id);
     }
-    return running_procs;
+    core_stats[core_id].available = true;
+    return true;
 }
 
-std::vector<std::shared_ptr<Process>> Scheduler::get_finished_processes()
+bool Scheduler::has_pending_work()
 {
-    std::vector<std::shared_ptr<Process>> finished_procs;
-    for (const auto &p : all_processes)
+    if (!ready_queue->empty())
+        return true;
+
+    for (const auto &core : core_states)
     {
-        if (p->is_finished)
-        {
-            finished_procs.push_back(p);
-        }
+        if (core.process)
+            return true;
     }
-    return finished_procs;
+    return false;
+}
+
+void Scheduler::start()
+{
+    // Generation is paced by on_cpu_cycle(); core threads are started at initialize
+    generating_processes.store(true);
+    running = true;
+}
+
+std::vector<std::shared_ptr<Process>> Scheduler::get_running_processes()
+{
+    return registry.list(ProcessState::RUNNING);
+}
+
+std::vector<RetiredProcess> Scheduler::get_finished_processes()
+{
+    return registry.retired();
+}
+
+bool Scheduler::find_finished_process(const std::string &name, RetiredProcess &record)
+{
+    return registry.find_retired(name, record);
 }
 
 std::vector<std::shared_ptr<Process>> Scheduler::get_all_processes()
 {
-    return all_processes;
+    return registry.all();
 }
 
-int Scheduler::get_core_of_process(const std::shared_ptr<Process>& p) {
-    std::unique_lock<std::mutex> lock(running_mutex);
-    auto it = process_to_core.find(p);
-    if (it != process_to_core.end()) {
-        return it->second;
-    }
-    return -1; // Not found
+int Scheduler::get_core_of_process(const std::shared_ptr<Process> &p)
+{
+    return p->getCurrentCore();
+}
+
+std::shared_ptr<Process> Scheduler::find_process_by_name(const std::string &name)
+{
+    return registry.find(name);
+}
+
+std::shared_ptr<Process> Scheduler::find_process_by_pid(int pid)
+{
+    return registry.find(pid);
 }
 
 bool Scheduler::is_done()
 {
-    std::unique_lock<std::mutex> lock(queue_mutex);
-    return ready_queue.empty() && std::all_of(core_available.begin(), core_available.end(), [](bool avail)
-                                              { return avail; });
+    // Sleepers first: one being woken stays counted until it is queued
+    if (!no_sleepers())
+        return false;
+
+    if (!ready_queue->empty())
+        return false;
+
+    for (int i = 0; i < num_cores; ++i)
+    {
+        if (!core_stats[i].available)
+            return false;
+    }
+    // Re-check: a preempted or sleeping process may have left its core
+    // during the scan
+    return no_sleepers() && ready_queue->empty();
+}
+
+bool Scheduler::no_sleepers()
+{
+    std::unique_lock<std::mutex> lock(sleepers_mutex);
+    return sleepers.empty() && waking.load() == 0;
 }
 
 void Scheduler::start_process_generator()
 {
-    std::cout << "[Scheduler] process gen()." << std::endl;
+    start();
+}
+
+bool Scheduler::is_scheduler_running() const
+{
+    return generating_processes;
 }
 
 std::map<int, std::map<std::string, float>> Scheduler::get_cpu_stats()
 {
     std::map<int, std::map<std::string, float>> stats;
-    std::unique_lock<std::mutex> lock(queue_mutex);
-    uint64_t safe_total_time = total_cpu_time > 0 ? total_cpu_time : 1;
-    for (size_t core_id = 0; core_id < core_available.size(); ++core_id)
+    for (int core_id = 0; core_id < num_cores; ++core_id)
     {
-        float util_percent = (static_cast<float>(core_util_time[core_id]) / safe_total_time) * 100.0f;
+        const CoreStats &core = core_stats[core_id];
+        // Share of clock ticks this core spent holding a process
+        uint64_t total_ticks = core.total_ticks.load(std::memory_order_relaxed);
+        uint64_t busy_ticks = core.busy_ticks.load(std::memory_order_relaxed);
+        float util_percent = total_ticks > 0 ? 100.0f * busy_ticks / total_ticks : 0.0f;
 
-        stats[static_cast<int>(core_id)]["util"] = util_percent;
-        stats[static_cast<int>(core_id)]["busy_time_ms"] = static_cast<float>(core_util_time[core_id]);
-        stats[static_cast<int>(core_id)]["process_count"] = static_cast<float>(core_process_count[core_id]);
-        stats[static_cast<int>(core_id)]["available"] = core_available[core_id] ? 1.0f : 0.0f;
+        stats[core_id]["util"] = util_percent;
+        stats[core_id]["busy_ticks"] = static_cast<float>(busy_ticks);
+        stats[core_id]["total_ticks"] = static_cast<float>(total_ticks);
+        stats[core_id]["busy_time_ms"] = core.busy_time_us.load(std::memory_order_relaxed) / 1000.0f;
+        stats[core_id]["process_count"] = static_cast<float>(core.dispatches.load(std::memory_order_relaxed));
+        stats[core_id]["available"] = core.available ? 1.0f : 0.0f;
     }
+    ready_queue->collect_stats(stats);
 
     return stats;
 }
@@ -182,7 +566,8 @@ std::map<int, std::map<std::string, float>> Scheduler::get_cpu_stats()
 void Scheduler::stop_scheduler()
 {
     generating_processes = false;
-    
+    if (generator)
+        generator->stop();
 
     if (generator_thread.joinable())
     {
@@ -2,14 +2,22 @@
 #pragma once
 
 #include "Process.h"
+#include "ReadyQueue.h"
+#include "ParkingLot.h"
+#include "TimerWheel.h"
+#include "VmStats.h"
+#include "ProcessGenerator.h"
+#include "ProcessRegistry.h"
 #include <vector>
-#include <queue>
 #include <map>
 #include <memory>
 #include <mutex>
-#include <condition_variable>
 #include <thread>
 #include <atomic>
+#include <condition_variable>
+#include <string>
+
+class ConfigManager;
 
 class Scheduler
 {
@@ -17,16 +25,24 @@ public:
     Scheduler(int num_cores, int min_instructions, int max_instructions);
     virtual ~Scheduler();
 
+    // Builds the scheduler named by the "scheduler" config key (fcfs, rr,
+    // mlfq, sjf, srtf, cfs, edf, lottery, stride); anything else falls back to FCFS
+    static std::unique_ptr<Scheduler> create(const std::string &type, const ConfigManager &cfg);
+    virtual std::string name() const = 0;
+
     virtual void run_core(int core_id);
 
     virtual void start_core_threads();
+    // Turns on tick-paced generation; policies only override to add to it
     virtual void start();
 
     void add_process(std::shared_ptr<Process> process);
+    // Joins the cores. Policies whose hooks touch their own members call it
+    // from their destructor, before those members are destroyed
     void shutdown();
 
     virtual std::vector<std::shared_ptr<Process>> get_running_processes();
-    std::vector<std::shared_ptr<Process>> get_finished_processes();
+    std::vector<RetiredProcess> get_finished_processes();
     std::vector<std::shared_ptr<Process>> get_all_processes();
     int get_core_of_process(const std::shared_ptr<Process>& p);
     virtual void start_process_generator();
@@ -34,38 +50,148 @@ public:
 
     int get_min_instructions() const { return min_instructions; }
     int get_max_instructions() const { return max_instructions; }
+    int get_num_cores() const { return num_cores; }
 
     bool is_done();
     std::shared_ptr<Process> find_process_by_name(const std::string &name);
-
-    virtual void on_cpu_cycle(uint64_t cycle_number) = 0;
+    std::shared_ptr<Process> find_process_by_pid(int pid);
+    // Record of a finished process by name; false if it has not finished
+    bool find_finished_process(const std::string &name, RetiredProcess &record);
+
+    // Tick-driven execution: advances core_id by one tick (one instruction or
+    // one delay step). Returns false if the core had nothing to run.
+    bool step_core(int core_id);
+    // True while anything is queued or still holding a core under step_core
+    bool has_pending_work();
+
+    // Called by the tick loop after each tick (elapsed > 1 for skipped spans)
+    void record_ticks(uint64_t elapsed, bool busy);
+    // Cores currently holding a process; lock-free, safe to call every tick
+    int get_busy_core_count() const { return busy_core_count.load(std::memory_order_relaxed); }
+    bool any_core_busy() const { return get_busy_core_count() > 0; }
+    const VmStats &get_vm_stats() const { return vm_stats; }
+
+    // Called once per CPU cycle by whichever clock drives the run: wakes
+    // sleepers that are due, then lets the subclass generate arrivals
+    void on_tick(uint64_t cycle_number);
+    // Takes the next pre-built process every batch-process-freq cycles
+    virtual void on_cpu_cycle(uint64_t cycle_number);
+    // Earliest tick a sleeping process wakes, or TimerWheel::NO_EXPIRY
+    uint64_t next_wakeup();
     virtual void set_batch_frequency(int freq) { batch_process_freq = freq; }
-
-    virtual bool is_scheduler_running() const = 0;
+    // Busy-wait steps after every instruction, applied to processes as they are added
+    void set_delay_per_exec(int delay) { delay_per_exec = delay; }
+    // Workload seed (same seed, same processes), background builder threads
+    // and how many processes they may build ahead
+    void set_generation(uint64_t seed, int threads, int buffer);
+    uint64_t get_seed() const { return seed; }
+    size_t get_buffered_processes() { return generator->buffered(); }
+    // A process for `screen -s`, seeded from the workload seed and its name;
+    // deadline_ticks > 0 makes it due that many ticks after admission;
+    // tickets > 0 overrides its ticket-groups share
+    std::shared_ptr<Process> create_named_process(const std::string &name, int nice = 0, int deadline_ticks = 0,
+                                                  int tickets = 0);
+    // Share of batch processes (0-100) that get a deadline, and how many
+    // ticks after admission it falls
+    void set_realtime(int percent, int deadline_ticks);
+    // Tick most recently passed to on_tick()
+    uint64_t get_current_tick() const { return current_tick.load(std::memory_order_relaxed); }
+    // Log records each process keeps before overwriting the oldest
+    void set_log_capacity(int capacity) { log_capacity = capacity; }
+
+    // Must be called before start_core_threads(); "mutex", "lockfree" or "work-stealing".
+    // Policies that order the queue themselves keep their own.
+    virtual void set_ready_queue(const std::string &type, int capacity);
+
+    virtual bool is_scheduler_running() const;
 
     virtual void stop_scheduler();
 
 protected:
-    std::vector<bool> core_available;
-    std::queue<std::shared_ptr<Process>> ready_queue;
-    std::vector<std::shared_ptr<Process>> all_processes;
-    std::map<int, std::shared_ptr<Process>> current_processes; // core_id -> Process
-    std::map<std::shared_ptr<Process>, int> process_to_core;
-    std::mutex running_mutex;
-    int next_pid = 0;
-
-    std::map<int, int> core_process_count;
-    std::map<int, int> core_util_time;
-    int total_cpu_time = 0;
-    bool running = true;
-    std::map<int, uint64_t> total_ticks_per_core;
-    std::map<int, uint64_t> busy_ticks_per_core;
-
-    std::mutex queue_mutex;
-    std::condition_variable queue_condition;
+    // Instructions a process may run per dispatch; 0 means run to completion
+    virtual int time_slice(const std::shared_ptr<Process> & /*process*/) const { return 0; }
+    // Policy hooks, called while no queue or core holds the process: after it
+    // used up its whole slice, and when it wakes from SLEEP
+    virtual void on_slice_expired(Process & /*process*/) {}
+    virtual void on_wake(Process & /*process*/) {}
+    // Called as a process takes and gives back core_id
+    virtual void on_dispatch(Process & /*process*/, int /*core_id*/) {}
+    virtual void on_finished(Process & /*process*/) {}
+    virtual void on_release(Process & /*process*/, int /*core_id*/) {}
+
+    // Makes core_id hand its process back to the ready queue at the next
+    // instruction boundary; cleared when the core dispatches again
+    void request_preemption(int core_id) { preempt_requested[core_id].store(true, std::memory_order_relaxed); }
+    bool preemption_requested(int core_id) const { return preempt_requested[core_id].load(std::memory_order_relaxed); }
+    // Ticks the process on core_id has held it for this dispatch, delay steps
+    // included; valid up to and inside on_release
+    uint64_t ticks_held(int core_id) const { return core_states[core_id].ticks_held; }
+
+    void enqueue_ready(std::shared_ptr<Process> process, int core_id);
+    std::shared_ptr<Process> next_process(int core_id);
+    // Parks a WAITING process on the timer wheel until its wake_tick
+    void sleep_process(std::shared_ptr<Process> process);
+    // Retires a finished process from the core that ran it
+    void finish_process(Process &process);
+    void wake_sleepers(uint64_t now);
+    bool no_sleepers();
+    // Builds the index-th batch process; runs on generator threads
+    std::shared_ptr<Process> build_batch_process(uint64_t index);
+    void generate_new_process();
+    // Maintain busy_cores / busy_core_count around a process holding a core
+    void mark_core_busy(int core_id);
+    void mark_core_idle(int core_id);
+    // Binds a process to a core (RUNNING) and releases it again
+    void dispatch(const std::shared_ptr<Process> &process, int core_id);
+    void release(Process &process, int core_id);
+
+    // Written by one core (and the tick loop for the tick counts), read on
+    // demand by get_cpu_stats(). One cache line each so cores never share.
+    struct alignas(64) CoreStats
+    {
+        std::atomic<bool> available{true}; // claimed before popping, see next_process()
+        std::atomic<uint64_t> dispatches{0};
+        std::atomic<uint64_t> busy_time_us{0}; // wall time inside run_core dispatches
+        std::atomic<uint64_t> total_ticks{0};
+        std::atomic<uint64_t> busy_ticks{0};
+    };
+
+    // Per-core state kept between step_core() calls
+    struct CoreState
+    {
+        std::shared_ptr<Process> process;
+        int slice_used = 0;
+        uint64_t ticks_held = 0; // instructions and delay steps since dispatch, both modes
+    };
+
+    int num_cores;
+    std::unique_ptr<CoreStats[]> core_stats;
+    std::unique_ptr<std::atomic<bool>[]> preempt_requested;
+    std::unique_ptr<ReadyQueue> ready_queue;
+    std::unique_ptr<ParkingLot> parking_lot;
+    std::vector<CoreState> core_states;
+    TimerWheel sleepers;
+    std::mutex sleepers_mutex;
+    // Woken but not yet in the ready queue; raised under sleepers_mutex
+    std::atomic<size_t> waking{0};
+    ProcessRegistry registry;
+
+    std::atomic<bool> running{true};
+
+    // One bit per core, 64 cores per word. busy_cores is set while a core
+    // holds a process; stepped_cores collects cores that released one since
+    // the last record_ticks, so a dispatch shorter than a tick still counts.
+    size_t core_words;
+    std::unique_ptr<std::atomic<uint64_t>[]> busy_cores;
+    std::unique_ptr<std::atomic<uint64_t>[]> stepped_cores;
+    std::atomic<int> busy_core_count{0};
+
+    VmStats vm_stats;
 
     std::thread generator_thread;
     std::atomic<bool> generating_processes{false};
+    std::unique_ptr<ProcessGenerator> generator;
+    uint64_t seed = 0;
     std::atomic<bool> global_shutdown{false};
 
     // config
@@ -74,5 +200,13 @@ protected:
     int max_instructions;
 
     std::atomic<uint64_t> cpu_cycles; // Shared CPU cycle counter
+    std::atomic<uint64_t> current_tick{0};
+    // Threaded cores sleep here between delay-per-exec steps
+    std::mutex tick_mutex;
+    std::condition_variable tick_cv;
+    int realtime_percent = 0;
+    int realtime_deadline = 0;
     int batch_process_freq;
+    int delay_per_exec = 0;
+    int log_capacity = static_cast<int>(LogRing::DEFAULT_CAPACITY);
 };
@@ -42,22 +42,27 @@ void ScreenConsole::draw() const
 
     std::cout << "\n--- Screen: " << m_name << " ---\n";
 
-    if (attachedProcess)
+    std::shared_ptr<Process> proc = getAttachedProcess();
+    if (proc)
     {
         std::ostringstream oss;
-        oss << " - " << attachedProcess->getName();
+        oss << " - " << proc->getName();
 
-        if (attachedProcess->hasStarted())
+        if (proc->hasStarted())
         {
-            auto start = std::chrono::system_clock::to_time_t(attachedProcess->getStartTime());
+            auto start = std::chrono::system_clock::to_time_t(proc->getStartTime());
             oss << " (" << std::put_time(std::localtime(&start), "%Y-%m-%d %H:%M:%S") << ")";
         }
 
-        oss << "  " << attachedProcess->getCurrentCommandIndex()
-            << " / " << attachedProcess->get_instruction_count();
+        oss << "  " << proc->getCurrentCommandIndex()
+            << " / " << proc->get_instruction_count();
 
         std::cout << oss.str() << "\n";
     }
+    else if (attachedPid > 0)
+    {
+        std::cout << "(Process finished; use process-smi for its summary)\n";
+    }
     else
     {
         std::cout << "(No process attached)\n";
@@ -90,10 +95,11 @@ bool ScreenConsole::isRunning() const
 
 void ScreenConsole::attachProcess(std::shared_ptr<Process> process)
 {
-    this->attachedProcess = process;
+    attachedPid = process ? process->getPid() : 0;
 }
 
 std::shared_ptr<Process> ScreenConsole::getAttachedProcess() const
 {
-    return attachedProcess;
+    Scheduler *scheduler = ConsoleManager::getInstance()->getScheduler();
+    return scheduler ? scheduler->find_process_by_pid(attachedPid) : nullptr;
 }
\ No newline at end of file
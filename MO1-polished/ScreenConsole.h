@@ -20,11 +20,14 @@ public:
     void onEnabled() override;
     void display() override;
     bool isRunning() const override;
-    std::shared_ptr<Process> attachedProcess;
+    // By PID, so a retired process's pool block is not pinned by its screen
+    int attachedPid = 0;
 
     void process(std::string &command) override;
     void attachProcess(std::shared_ptr<Process> process);
+    // nullptr once the process has been retired and released by the registry
     std::shared_ptr<Process> getAttachedProcess() const;
+    const std::string &getName() const { return m_name; }
 
 private:
     std::string m_name;
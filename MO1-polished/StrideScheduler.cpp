@@ -0,0 +1,40 @@
+#include "StrideScheduler.h"
+#include "Process.h"
+
+#include <algorithm>
+
+StrideScheduler::StrideScheduler(int num_cores, int min_ins, int max_ins, int quantum,
+                                 std::vector<TicketGroup> groups, int default_tickets)
+    : ProportionalShareScheduler(num_cores, min_ins, max_ins, quantum, std::move(groups), default_tickets)
+{
+    set_ready_queue("", 0);
+}
+
+std::unique_ptr<ProportionalShareScheduler::ShareQueue> StrideScheduler::make_queue(const std::vector<TicketGroup> &groups,
+                                                                                    uint32_t default_tickets)
+{
+    return std::make_unique<PassQueue>(groups, default_tickets);
+}
+
+void StrideScheduler::PassQueue::insert(std::shared_ptr<Process> process)
+{
+    process->sched.pass = std::max(process->sched.pass, global_pass);
+    heap.push(Entry{process->sched.pass, next_sequence++, std::move(process)});
+}
+
+std::shared_ptr<Process> StrideScheduler::PassQueue::remove_next()
+{
+    if (heap.empty())
+        return nullptr;
+
+    Entry top = heap.top();
+    heap.pop();
+    global_pass = std::max(global_pass, top.pass);
+    return std::move(top.process);
+}
+
+void StrideScheduler::PassQueue::on_charge(Process &process, uint64_t ran)
+{
+    // Only the core holding the process touches its pass until it is queued again
+    process.sched.pass += STRIDE1 / process.sched.tickets * ran;
+}
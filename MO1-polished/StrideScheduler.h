@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ProportionalShareScheduler.h"
+#include <queue>
+#include <vector>
+
+// Stride scheduling: the deterministic counterpart of lottery. Each process
+// advances a pass value by STRIDE1 / tickets per tick it runs, and the
+// smallest pass is dispatched next from a min-heap. Arrivals and wake-ups
+// start at the global pass so time spent away does not bank credit.
+class StrideScheduler : public ProportionalShareScheduler
+{
+public:
+    static constexpr uint64_t STRIDE1 = 1 << 20;
+
+    StrideScheduler(int num_cores, int min_ins, int max_ins, int quantum,
+                    std::vector<TicketGroup> groups, int default_tickets);
+
+    std::string name() const override { return "Stride Scheduler"; }
+
+protected:
+    std::unique_ptr<ShareQueue> make_queue(const std::vector<TicketGroup> &groups, uint32_t default_tickets) override;
+
+private:
+    class PassQueue : public ShareQueue
+    {
+    public:
+        using ShareQueue::ShareQueue;
+
+    protected:
+        void insert(std::shared_ptr<Process> process) override;
+        std::shared_ptr<Process> remove_next() override;
+        void on_charge(Process &process, uint64_t ran) override;
+
+    private:
+        struct Entry
+        {
+            uint64_t pass;
+            uint64_t sequence; // FIFO among equal passes
+            std::shared_ptr<Process> process;
+
+            bool operator>(const Entry &other) const
+            {
+                return pass != other.pass ? pass > other.pass : sequence > other.sequence;
+            }
+        };
+
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+        uint64_t next_sequence = 0;
+        uint64_t global_pass = 0; // pass of the last process dispatched
+    };
+};
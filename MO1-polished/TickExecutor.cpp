@@ -0,0 +1,91 @@
+#include "TickExecutor.h"
+#include "Scheduler.h"
+
+#include <algorithm>
+#include <cstdint>
+
+TickBarrier::TickBarrier(int participants) : participants(participants) {}
+
+void TickBarrier::arrive_and_wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t arrival_phase = phase;
+
+    if (++waiting == participants)
+    {
+        waiting = 0;
+        phase++;
+        condition.notify_all();
+        return;
+    }
+
+    condition.wait(lock, [this, arrival_phase]
+                   { return phase != arrival_phase; });
+}
+
+// The tick thread is the extra participant
+TickExecutor::TickExecutor(Scheduler *scheduler, int num_cores, int num_workers)
+    : scheduler(scheduler),
+      barrier(std::max(1, std::min(num_workers, num_cores)) + 1)
+{
+    int workers = std::max(1, std::min(num_workers, num_cores));
+
+    // Contiguous batches keep each worker on the same cores every tick
+    for (int w = 0; w < workers; ++w)
+    {
+        int first = static_cast<int>(static_cast<int64_t>(num_cores) * w / workers);
+        int last = static_cast<int>(static_cast<int64_t>(num_cores) * (w + 1) / workers);
+        threads.emplace_back(&TickExecutor::worker_loop, this, first, last);
+    }
+}
+
+TickExecutor::~TickExecutor()
+{
+    stop();
+}
+
+int TickExecutor::run_tick()
+{
+    if (stopping)
+        return 0;
+
+    busy_cores = 0;
+    barrier.arrive_and_wait(); // release the cores
+    barrier.arrive_and_wait(); // wait for every core to finish its step
+    return busy_cores.load();
+}
+
+void TickExecutor::stop()
+{
+    if (stopping.exchange(true))
+        return;
+
+    // Cores are parked on the release phase; let them observe stopping
+    barrier.arrive_and_wait();
+    for (auto &t : threads)
+    {
+        if (t.joinable())
+            t.join();
+    }
+}
+
+void TickExecutor::worker_loop(int first_core, int last_core)
+{
+    for (;;)
+    {
+        barrier.arrive_and_wait();
+        if (stopping)
+            return;
+
+        int busy = 0;
+        for (int core_id = first_core; core_id < last_core; ++core_id)
+        {
+            if (scheduler->step_core(core_id))
+                busy++;
+        }
+        if (busy > 0)
+            busy_cores.fetch_add(busy);
+
+        barrier.arrive_and_wait();
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Scheduler;
+
+// Reusable phase barrier in the style of C++20 std::barrier (we build as C++17)
+class TickBarrier
+{
+public:
+    explicit TickBarrier(int participants);
+
+    void arrive_and_wait();
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    int participants;
+    int waiting = 0;
+    uint64_t phase = 0;
+};
+
+// Drives simulated cores one step_core() per CPU tick. Worker threads are
+// released through the barrier once per tick, advance their batch of cores
+// and park again, so idle cores cost no host CPU and instruction pacing
+// follows cpu_cycles.
+//   exec-mode lockstep: one worker per simulated core
+//   exec-mode pooled:   a fixed pool (M:N); cores are just state objects
+class TickExecutor
+{
+public:
+    TickExecutor(Scheduler *scheduler, int num_cores, int num_workers);
+    ~TickExecutor();
+
+    int get_num_workers() const { return static_cast<int>(threads.size()); }
+
+    // Called from the tick thread; returns once every core finished its step.
+    // Returns the number of cores that were busy this tick.
+    int run_tick();
+    void stop();
+
+private:
+    void worker_loop(int first_core, int last_core);
+
+    Scheduler *scheduler;
+    TickBarrier barrier;
+    std::vector<std::thread> threads;
+    std::atomic<bool> stopping{false};
+    std::atomic<int> busy_cores{0};
+};
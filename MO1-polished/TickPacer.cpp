@@ -0,0 +1,85 @@
+#include "TickPacer.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+    // How early to stop sleeping and start spinning. Windows sleeps in
+    // timer-interrupt steps, so it needs a wider margin.
+#ifdef _WIN32
+    constexpr auto SPIN_MARGIN = std::chrono::milliseconds(2);
+#else
+    constexpr auto SPIN_MARGIN = std::chrono::microseconds(200);
+#endif
+}
+
+TickPacer::TickPacer(double hz)
+    : hz(std::min(std::max(hz, MIN_HZ), MAX_HZ))
+{
+    period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / this->hz));
+    if (period <= Clock::duration::zero())
+        period = Clock::duration(1);
+    reset();
+}
+
+void TickPacer::reset()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    interrupted = false;
+    deadline = Clock::now() + period;
+}
+
+void TickPacer::interrupt()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        interrupted = true;
+    }
+    wake.notify_all();
+}
+
+bool TickPacer::wait()
+{
+    Clock::time_point now = Clock::now();
+
+    if (now > deadline)
+    {
+        overruns.fetch_add(1, std::memory_order_relaxed);
+        // More than a period behind: drop the missed periods instead of
+        // bursting through them
+        if (now - deadline >= period)
+        {
+            uint64_t missed = static_cast<uint64_t>((now - deadline) / period);
+            skipped.fetch_add(missed, std::memory_order_relaxed);
+            deadline += period * static_cast<Clock::rep>(missed);
+        }
+    }
+    else
+    {
+        if (deadline - now > SPIN_MARGIN)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (wake.wait_until(lock, deadline - SPIN_MARGIN, [this]
+                                { return interrupted; }))
+                return false;
+        }
+        while ((now = Clock::now()) < deadline)
+            std::this_thread::yield();
+    }
+
+    uint64_t late = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline).count());
+    total_jitter_ns.fetch_add(late, std::memory_order_relaxed);
+    if (late > max_jitter_ns.load(std::memory_order_relaxed))
+        max_jitter_ns.store(late, std::memory_order_relaxed);
+    ticks.fetch_add(1, std::memory_order_relaxed);
+
+    deadline += period;
+    return true;
+}
+
+uint64_t TickPacer::get_mean_jitter_ns() const
+{
+    uint64_t n = ticks.load(std::memory_order_relaxed);
+    return n ? total_jitter_ns.load(std::memory_order_relaxed) / n : 0;
+}
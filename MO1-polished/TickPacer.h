@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// Paces a real-time tick loop against absolute deadlines (start + n * period),
+// so time spent inside a tick does not push every later tick back. Sleeps
+// until shortly before each deadline and spins the rest, which keeps rates
+// in the tens of kHz usable where the OS sleep granularity is coarse.
+// wait() is called from the tick thread only; interrupt() and the counters
+// may be used from anywhere.
+class TickPacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr double MIN_HZ = 0.1;
+    static constexpr double MAX_HZ = 100000.0;
+
+    explicit TickPacer(double hz);
+
+    // Restarts the schedule from now and clears a pending interrupt
+    void reset();
+    // Blocks until the next tick is due; false if interrupt() cut it short
+    bool wait();
+    // Wakes wait() now instead of at the deadline, so shutdown does not
+    // wait out a long period
+    void interrupt();
+
+    double get_hz() const { return hz; }
+    uint64_t get_ticks() const { return ticks.load(std::memory_order_relaxed); }
+    // Ticks whose deadline had already passed when the loop came back to wait
+    uint64_t get_overruns() const { return overruns.load(std::memory_order_relaxed); }
+    // Periods dropped after falling more than a full period behind
+    uint64_t get_skipped() const { return skipped.load(std::memory_order_relaxed); }
+    // Wake-up lateness past the deadline
+    uint64_t get_max_jitter_ns() const { return max_jitter_ns.load(std::memory_order_relaxed); }
+    uint64_t get_mean_jitter_ns() const;
+
+private:
+    double hz;
+    Clock::duration period;
+    Clock::time_point deadline;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool interrupted = false;
+
+    std::atomic<uint64_t> ticks{0};
+    std::atomic<uint64_t> overruns{0};
+    std::atomic<uint64_t> skipped{0};
+    std::atomic<uint64_t> max_jitter_ns{0};
+    std::atomic<uint64_t> total_jitter_ns{0};
+};
@@ -0,0 +1,124 @@
+#include "TimerWheel.h"
+#include "Process.h"
+
+#include <algorithm>
+
+TimerWheel::TimerWheel(uint64_t start_tick) : current_tick(start_tick) {}
+
+void TimerWheel::schedule(std::shared_ptr<Process> process, uint64_t expiry)
+{
+    place({std::move(process), expiry});
+    count++;
+}
+
+void TimerWheel::place(Entry entry)
+{
+    if (entry.expiry <= current_tick)
+    {
+        due.push_back(std::move(entry));
+        return;
+    }
+
+    // Lowest level whose enclosing window also holds current_tick
+    for (int level = 0; level < LEVELS; ++level)
+    {
+        int upper_shift = SLOT_BITS * (level + 1);
+        if ((entry.expiry >> upper_shift) == (current_tick >> upper_shift))
+        {
+            size_t slot = (entry.expiry >> (SLOT_BITS * level)) & SLOT_MASK;
+            wheels[level][slot].push_back(std::move(entry));
+            return;
+        }
+    }
+    overflow.push_back(std::move(entry));
+}
+
+void TimerWheel::cascade(int level)
+{
+    size_t slot = (current_tick >> (SLOT_BITS * level)) & SLOT_MASK;
+    std::vector<Entry> entries;
+    entries.swap(wheels[level][slot]);
+    for (auto &entry : entries)
+        place(std::move(entry));
+}
+
+void TimerWheel::advance(uint64_t now, std::vector<std::shared_ptr<Process>> &expired)
+{
+    for (auto &entry : due)
+        expired.push_back(std::move(entry.process));
+    count -= due.size();
+    due.clear();
+
+    while (current_tick < now)
+    {
+        if (count == 0)
+        {
+            current_tick = now;
+            break;
+        }
+
+        current_tick++;
+
+        // Entering a new window at some level: pull its slot down, highest first
+        if ((current_tick & ((uint64_t(1) << (SLOT_BITS * LEVELS)) - 1)) == 0)
+        {
+            std::vector<Entry> entries;
+            entries.swap(overflow);
+            for (auto &entry : entries)
+                place(std::move(entry));
+        }
+        for (int level = LEVELS - 1; level >= 1; --level)
+        {
+            if ((current_tick & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) == 0)
+                cascade(level);
+        }
+
+        auto &slot = wheels[0][current_tick & SLOT_MASK];
+        for (auto &entry : slot)
+            expired.push_back(std::move(entry.process));
+        count -= slot.size();
+        slot.clear();
+
+        // Cascades can land entries that are already due
+        for (auto &entry : due)
+            expired.push_back(std::move(entry.process));
+        count -= due.size();
+        due.clear();
+    }
+}
+
+uint64_t TimerWheel::next_expiry() const
+{
+    if (count == 0)
+        return NO_EXPIRY;
+    if (!due.empty())
+        return current_tick;
+
+    for (uint64_t t = current_tick + 1; (t >> SLOT_BITS) == (current_tick >> SLOT_BITS); ++t)
+    {
+        if (!wheels[0][t & SLOT_MASK].empty())
+            return t;
+    }
+
+    // Slots further out at each level hold strictly later windows
+    for (int level = 1; level < LEVELS; ++level)
+    {
+        size_t first = ((current_tick >> (SLOT_BITS * level)) & SLOT_MASK) + 1;
+        for (size_t slot = first; slot < SLOTS; ++slot)
+        {
+            const auto &entries = wheels[level][slot];
+            if (entries.empty())
+                continue;
+
+            uint64_t earliest = NO_EXPIRY;
+            for (const auto &entry : entries)
+                earliest = std::min(earliest, entry.expiry);
+            return earliest;
+        }
+    }
+
+    uint64_t earliest = NO_EXPIRY;
+    for (const auto &entry : overflow)
+        earliest = std::min(earliest, entry.expiry);
+    return earliest;
+}
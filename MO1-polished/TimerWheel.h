@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Process;
+
+// Hierarchical timing wheel keyed on absolute cpu_cycles. Four levels of 64
+// slots cover 2^24 ticks; anything further out waits in an overflow list.
+// Insert is O(1); advance() costs one slot per elapsed tick plus cascades.
+// Not thread-safe: Scheduler guards it with sleepers_mutex.
+class TimerWheel
+{
+public:
+    static constexpr uint64_t NO_EXPIRY = UINT64_MAX;
+
+    explicit TimerWheel(uint64_t start_tick = 0);
+
+    void schedule(std::shared_ptr<Process> process, uint64_t expiry);
+
+    // Moves the wheel to now and appends every process whose expiry <= now
+    void advance(uint64_t now, std::vector<std::shared_ptr<Process>> &expired);
+
+    // Earliest pending expiry, or NO_EXPIRY when empty
+    uint64_t next_expiry() const;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+
+    struct Entry
+    {
+        std::shared_ptr<Process> process;
+        uint64_t expiry;
+    };
+
+    void place(Entry entry);
+    void cascade(int level);
+
+    std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> wheels;
+    std::vector<Entry> overflow;
+    std::vector<Entry> due; // scheduled at or before current_tick
+    uint64_t current_tick;
+    size_t count = 0;
+};
@@ -0,0 +1,119 @@
+#include "VirtualTimeEngine.h"
+#include "Scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+VirtualTimeEngine::VirtualTimeEngine(Scheduler *scheduler, std::atomic<uint64_t> &clock,
+                                     int batch_freq, uint64_t generation_ticks)
+    : scheduler(scheduler), clock(clock),
+      batch_freq(static_cast<uint64_t>(std::max(batch_freq, 1))),
+      generation_ticks(generation_ticks)
+{
+}
+
+void VirtualTimeEngine::schedule(uint64_t tick, SimEventType type)
+{
+    events.push({tick, type});
+}
+
+void VirtualTimeEngine::plan_next_events()
+{
+    uint64_t now = clock.load();
+
+    if (!tick_pending && scheduler->has_pending_work())
+    {
+        schedule(now + 1, SimEventType::CPU_TICK);
+        tick_pending = true;
+    }
+
+    // Sleepers alone keep no core busy; jump straight to the next wake-up
+    uint64_t wake = scheduler->next_wakeup();
+    if (wake != TimerWheel::NO_EXPIRY)
+    {
+        wake = std::max(wake, now + 1);
+        if (wakeup_pending == 0 || wake < wakeup_pending)
+        {
+            schedule(wake, SimEventType::WAKEUP);
+            wakeup_pending = wake;
+        }
+    }
+
+    if (!generate_pending && scheduler->is_scheduler_running())
+    {
+        if (generation_ticks > 0 && generation_deadline == 0)
+            generation_deadline = now + generation_ticks;
+
+        uint64_t next = (now / batch_freq + 1) * batch_freq;
+        if (generation_deadline == 0 || next <= generation_deadline)
+        {
+            schedule(next, SimEventType::GENERATE);
+            generate_pending = true;
+        }
+        else
+        {
+            scheduler->stop_scheduler();
+        }
+    }
+}
+
+bool VirtualTimeEngine::advance(uint64_t &elapsed, bool &busy)
+{
+    plan_next_events();
+    if (events.empty())
+        return false;
+
+    uint64_t now = clock.load();
+    uint64_t tick = events.top().tick;
+
+    // Everything due at this tick is handled by one simulated cycle
+    while (!events.empty() && events.top().tick == tick)
+    {
+        switch (events.top().type)
+        {
+        case SimEventType::CPU_TICK:
+            tick_pending = false;
+            break;
+        case SimEventType::GENERATE:
+            generate_pending = false;
+            break;
+        case SimEventType::WAKEUP:
+            if (events.top().tick == wakeup_pending)
+                wakeup_pending = 0;
+            break;
+        }
+        events.pop();
+    }
+
+    elapsed = tick - now;
+    if (elapsed > 1)
+        skipped_ticks.fetch_add(elapsed - 1);
+    clock.store(tick);
+
+    scheduler->on_tick(tick);
+
+    busy = false;
+    for (int core_id = 0; core_id < scheduler->get_num_cores(); ++core_id)
+    {
+        if (scheduler->step_core(core_id))
+            busy = true;
+    }
+    return true;
+}
+
+void VirtualTimeEngine::wait_for_work()
+{
+    std::unique_lock<std::mutex> lock(wait_mutex);
+    wait_condition.wait_for(lock, std::chrono::milliseconds(50), [this]
+                            { return notified; });
+    notified = false;
+}
+
+void VirtualTimeEngine::notify()
+{
+    {
+        std::unique_lock<std::mutex> lock(wait_mutex);
+        notified = true;
+    }
+    wait_condition.notify_one();
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+class Scheduler;
+
+enum class SimEventType
+{
+    CPU_TICK, // at least one core has work on the next tick
+    GENERATE, // batch generator fires (multiples of batch-process-freq)
+    WAKEUP    // earliest sleeper on the scheduler's timer wheel is due
+};
+
+struct SimEvent
+{
+    uint64_t tick;
+    SimEventType type;
+
+    bool operator>(const SimEvent &other) const { return tick > other.tick; }
+};
+
+// Discrete-event driver for exec-mode "virtual". Ticks are events on a
+// min-heap keyed by virtual time; cores are stepped against that clock with
+// no sleeping, and spans where nothing can happen are skipped outright.
+class VirtualTimeEngine
+{
+public:
+    // generation_ticks bounds how long the batch generator runs once started
+    // (0 = until scheduler-stop)
+    VirtualTimeEngine(Scheduler *scheduler, std::atomic<uint64_t> &clock,
+                      int batch_freq, uint64_t generation_ticks);
+
+    // Simulates the next tick that has an event. elapsed includes skipped idle
+    // ticks. Returns false when there is nothing left to simulate.
+    bool advance(uint64_t &elapsed, bool &busy);
+
+    // Blocks until notify() or the timeout; used when advance() returns false
+    void wait_for_work();
+    void notify();
+
+    uint64_t get_skipped_ticks() const { return skipped_ticks.load(); }
+
+private:
+    void schedule(uint64_t tick, SimEventType type);
+    void plan_next_events();
+
+    Scheduler *scheduler;
+    std::atomic<uint64_t> &clock;
+    uint64_t batch_freq;
+    uint64_t generation_ticks;
+    uint64_t generation_deadline = 0;
+
+    std::priority_queue<SimEvent, std::vector<SimEvent>, std::greater<SimEvent>> events;
+    bool tick_pending = false;
+    bool generate_pending = false;
+    uint64_t wakeup_pending = 0; // tick of the earliest queued WAKEUP, 0 if none
+
+    std::atomic<uint64_t> skipped_ticks{0};
+
+    std::mutex wait_mutex;
+    std::condition_variable wait_condition;
+    bool notified = false;
+};
@@ -0,0 +1,64 @@
+#include "VmStats.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <cstdio>
+#include <unistd.h>
+#endif
+
+void VmStats::record_ticks(uint64_t elapsed, bool busy, uint64_t ready)
+{
+    if (elapsed == 0)
+        return;
+
+    uint64_t active = busy ? 1 : 0;
+    total_ticks.fetch_add(elapsed, std::memory_order_relaxed);
+    active_ticks.fetch_add(active, std::memory_order_relaxed);
+    idle_ticks.fetch_add(elapsed - active, std::memory_order_relaxed);
+
+    ready_depth.store(ready, std::memory_order_relaxed);
+    // Only the tick loop writes the peak, so no compare-exchange is needed
+    if (ready > peak_ready_depth.load(std::memory_order_relaxed))
+        peak_ready_depth.store(ready, std::memory_order_relaxed);
+}
+
+void VmStats::record_deadline(uint64_t finish_tick, uint64_t deadline)
+{
+    if (finish_tick <= deadline)
+    {
+        deadlines_met.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    uint64_t lateness = finish_tick - deadline;
+    deadlines_missed.fetch_add(1, std::memory_order_relaxed);
+    total_lateness.fetch_add(lateness, std::memory_order_relaxed);
+    // Cores finish concurrently, unlike the tick loop's peak above
+    uint64_t seen = max_lateness.load(std::memory_order_relaxed);
+    while (lateness > seen && !max_lateness.compare_exchange_weak(seen, lateness, std::memory_order_relaxed))
+    {
+    }
+}
+
+size_t host_resident_bytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.WorkingSetSize;
+    return 0;
+#else
+    FILE *statm = std::fopen("/proc/self/statm", "r");
+    if (!statm)
+        return 0;
+
+    unsigned long size = 0, resident = 0;
+    int fields = std::fscanf(statm, "%lu %lu", &size, &resident);
+    std::fclose(statm);
+    if (fields != 2)
+        return 0;
+    return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// System-wide counters behind the vmstat command. Writers bump them with
+// relaxed atomics from the tick loop and the cores; readers get an O(1)
+// snapshot without touching any process.
+struct VmStats
+{
+    std::atomic<uint64_t> total_ticks{0};
+    std::atomic<uint64_t> active_ticks{0}; // ticks where at least one core ran
+    std::atomic<uint64_t> idle_ticks{0};   // includes ticks skipped in virtual time
+
+    std::atomic<uint64_t> ready_depth{0}; // sampled at the last tick
+    std::atomic<uint64_t> peak_ready_depth{0};
+    std::atomic<uint64_t> sleeping{0};
+
+    std::atomic<uint64_t> processes_created{0};
+    std::atomic<uint64_t> processes_finished{0};
+
+    // Processes with a deadline, counted as they finish
+    std::atomic<uint64_t> deadlines_met{0};
+    std::atomic<uint64_t> deadlines_missed{0};
+    std::atomic<uint64_t> total_lateness{0}; // ticks past the deadline, over misses
+    std::atomic<uint64_t> max_lateness{0};
+
+    // elapsed > 1 when a clock skips idle ticks; only the last can be busy
+    void record_ticks(uint64_t elapsed, bool busy, uint64_t ready);
+    // Called from any core as a deadline process finishes
+    void record_deadline(uint64_t finish_tick, uint64_t deadline);
+};
+
+// Resident set size of the emulator itself, 0 if the host cannot tell
+size_t host_resident_bytes();
@@ -0,0 +1,92 @@
+// Interpreter microbenchmark: instructions per second one core gets out of
+// Process::execute. Builds deterministic programs from ADD/SUB/DECLARE
+// ("straight") and from FOR loops over ADD/DECLARE ("loops"), runs each to
+// completion and keeps the best of several runs.
+//
+// Build from MO1-polished with every source the README lists except main.cpp:
+//   g++ -std=c++17 -O2 -pthread bench/InterpreterBench.cpp <sources> -o interpreter-bench -lpsapi
+// then `./interpreter-bench [commands] [runs]`.
+#include "../Command.h"
+#include "../Process.h"
+#include "../ProcessFactory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+namespace
+{
+    const char *const VARS[] = {"a", "b", "c", "temp", "sum", "diff"};
+
+    std::shared_ptr<Process> build(int commands, bool loops)
+    {
+        auto process = std::make_shared<Process>("bench");
+        Arena &arena = process->arena;
+        WorkloadRng gen(loops ? 2 : 1);
+
+        for (int i = 0; i < commands; ++i)
+        {
+            const char *target = VARS[gen() % 6];
+            const char *op1 = VARS[gen() % 6];
+            const char *op2 = VARS[gen() % 6];
+            uint16_t value = static_cast<uint16_t>(gen.between(1, 500));
+
+            if (loops)
+            {
+                Command **body = arena.allocate_array<Command *>(2);
+                body[0] = arena.create<AddCommand>(target, op1, op2, true, false, 0, value);
+                body[1] = arena.create<DeclareCommand>(op1, value);
+                process->add_command(arena.create<ForCommand>(body, 2, gen.between(2, 5)));
+                continue;
+            }
+
+            switch (gen() % 3)
+            {
+            case 0:
+                process->add_command(arena.create<AddCommand>(target, op1, op2, true, true, 0, 0));
+                break;
+            case 1:
+                process->add_command(arena.create<SubtractCommand>(target, op1, op2, true, false, 0, value));
+                break;
+            default:
+                process->add_command(arena.create<DeclareCommand>(target, value));
+                break;
+            }
+        }
+        return process;
+    }
+
+    // Instructions per second; the first call compiles and is not timed
+    double run(int commands, bool loops)
+    {
+        auto process = build(commands, loops);
+        process->execute(0);
+
+        int start_index = process->getCurrentCommandIndex();
+        auto start = std::chrono::steady_clock::now();
+        while (!process->isFinished())
+            process->execute(0);
+        auto end = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        return (process->getCurrentCommandIndex() - start_index) / seconds;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int commands = argc > 1 ? std::atoi(argv[1]) : 200000;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    for (bool loops : {false, true})
+    {
+        double best = 0;
+        for (int i = 0; i < runs; ++i)
+            best = std::max(best, run(commands, loops));
+        std::printf("%-8s %10.2f M instructions/sec\n", loops ? "loops" : "straight", best / 1e6);
+    }
+    return 0;
+}
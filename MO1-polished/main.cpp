@@ -1,5 +1,6 @@
 #include "ConsoleManager.h"
 #include "Scheduler.h"
+#include "MemoryManager.h"
 
 int main()
 {
@@ -12,5 +13,6 @@ int main()
     }
 
     ConsoleManager::destroy();
+    MemoryManager::destroy();
     return 0;
 }
\ No newline at end of file